@@ -0,0 +1,103 @@
+#include <math.h>
+#include "inc/audio/level.h"
+
+void level_window_reset(level_window_t *w) {
+  w->signal_max = 0;
+  w->signal_min = LEVEL_ADC_MAX;
+  w->count = 0;
+  w->clip_high = 0;
+  w->clip_low = 0;
+  w->sum = 0;
+}
+
+void level_window_push_block(level_window_t *w, const uint16_t *samples, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    level_window_push(w, samples[i]);
+}
+
+void level_window_merge(level_window_t *dst, const level_window_t *src) {
+  dst->clip_high += src->clip_high;
+  dst->clip_low += src->clip_low;
+  if (src->count == 0)
+    return;
+
+  if (src->signal_max > dst->signal_max)
+    dst->signal_max = src->signal_max;
+  if (src->signal_min < dst->signal_min)
+    dst->signal_min = src->signal_min;
+  dst->sum += src->sum;
+  dst->count += src->count;
+}
+
+uint16_t level_window_peak_to_peak(const level_window_t *w) {
+  if (w->count == 0)
+    return 0;
+
+  return w->signal_max - w->signal_min;
+}
+
+uint16_t level_window_dc_offset(const level_window_t *w) {
+  if (w->count == 0)
+    return 0;
+
+  return (uint16_t)((w->sum + w->count / 2) / w->count);
+}
+
+unsigned int level_window_flags(const level_window_t *w) {
+  unsigned int flags = 0;
+
+  if (w->clip_high || w->clip_low)
+    flags |= LEVEL_FLAG_OVERLOAD;
+  if (level_window_peak_to_peak(w) < LEVEL_UNDERRANGE_P2P)
+    flags |= LEVEL_FLAG_UNDERRANGE;
+  return flags;
+}
+
+unsigned int level_convert_to_db(uint16_t peak_to_peak) {
+  // log10(0) não é definido: sem variação o nível é 0 dB
+  if (peak_to_peak == 0)
+    return 0;
+
+  return (unsigned int) round(20.0 * log10((double) peak_to_peak));
+}
+
+void level_reading_update(level_reading_t *r, const level_window_t *w) {
+  r->flags = level_window_flags(w);
+  r->valid = level_window_valid(w);
+  if (!r->valid)
+    return;
+
+  r->peak_to_peak = level_window_peak_to_peak(w);
+  r->db = level_convert_to_db(r->peak_to_peak);
+}
+
+void level_noise_reset(level_noise_t *n) {
+  n->floor_q8 = 0;
+  n->windows = 0;
+}
+
+void level_noise_update(level_noise_t *n, uint16_t peak_to_peak) {
+  uint32_t p2p_q8 = (uint32_t)peak_to_peak << 8;
+  if (n->windows == 0 || p2p_q8 < n->floor_q8)
+    n->floor_q8 = p2p_q8;
+  else
+    n->floor_q8 += (p2p_q8 - n->floor_q8) / LEVEL_NOISE_RISE;
+  n->windows++;
+}
+
+uint16_t level_noise_floor(const level_noise_t *n) {
+  return (uint16_t)((n->floor_q8 + 128) >> 8);
+}
+
+unsigned int level_dynamic_range_db(const level_noise_t *n) {
+  // Fundo de escala: maior pico a pico sem saturar
+  const double full_scale = LEVEL_ADC_MAX - 2;
+  uint16_t floor = level_noise_floor(n);
+
+  if (n->windows == 0)
+    return 0;
+  // Piso abaixo de um passo do ADC: a faixa é limitada pela resolução
+  if (floor < 1)
+    floor = 1;
+  return (unsigned int) round(20.0 * log10(full_scale / floor));
+}
@@ -0,0 +1,146 @@
+#ifndef __LEVEL_INC
+#define __LEVEL_INC
+
+// Cálculo do nível sonoro a partir das amostras do ADC. Não depende do SDK do
+// Pico para que o mesmo código seja usado no firmware e nas ferramentas do host.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Limites do ADC de 12 bits. Amostras nos trilhos (0 ou LEVEL_ADC_MAX) indicam
+// saturação: são contadas, mas não entram no máximo, no mínimo nem no nível DC.
+#define LEVEL_ADC_MAX 4095
+#define LEVEL_ADC_MIN 0
+
+// Abaixo deste pico a pico (em passos do ADC) o sinal se confunde com a resolução do ADC
+#define LEVEL_UNDERRANGE_P2P 4
+
+// Estado de uma janela de medição. Todos os campos são contadores incrementais,
+// então janelas parciais podem ser combinadas com level_window_merge().
+typedef struct {
+  uint16_t signal_max;
+  uint16_t signal_min;
+  uint32_t count;     // quantidade de amostras válidas
+  uint32_t clip_high; // amostras em LEVEL_ADC_MAX
+  uint32_t clip_low;  // amostras em LEVEL_ADC_MIN
+  uint64_t sum;       // soma das amostras válidas (nível DC)
+} level_window_t;
+
+// Diagnóstico de uma janela
+#define LEVEL_FLAG_OVERLOAD (1u << 0)   // alguma amostra saturou: a leitura é inválida
+#define LEVEL_FLAG_UNDERRANGE (1u << 1) // sinal abaixo da resolução útil do ADC
+
+// Reinicia a janela de medição
+void level_window_reset(level_window_t *w);
+
+// Acumula uma amostra na janela. Máximo e mínimo são atualizados de forma
+// independente, assim a mesma amostra pode alterar os dois.
+static inline void level_window_push(level_window_t *w, uint16_t sample) {
+  if (sample >= LEVEL_ADC_MAX) {
+    w->clip_high++;
+    return;
+  }
+  if (sample <= LEVEL_ADC_MIN) {
+    w->clip_low++;
+    return;
+  }
+
+  if (sample > w->signal_max)
+    w->signal_max = sample;
+  if (sample < w->signal_min)
+    w->signal_min = sample;
+  w->sum += sample;
+  w->count++;
+}
+
+// Acumula um bloco de amostras (referência escalar)
+void level_window_push_block(level_window_t *w, const uint16_t *samples, size_t n);
+
+// Combina duas janelas parciais, como se as amostras tivessem sido acumuladas em sequência
+void level_window_merge(level_window_t *dst, const level_window_t *src);
+
+// Retorna o valor pico a pico da janela (0 se nenhuma amostra válida foi lida)
+uint16_t level_window_peak_to_peak(const level_window_t *w);
+
+// Nível DC médio das amostras válidas (0 se não houver nenhuma)
+uint16_t level_window_dc_offset(const level_window_t *w);
+
+// Retorna os indicadores LEVEL_FLAG_* da janela
+unsigned int level_window_flags(const level_window_t *w);
+
+// A leitura só é válida se houver amostras e nenhuma tiver saturado
+static inline bool level_window_valid(const level_window_t *w) {
+  return w->count > 0 && (level_window_flags(w) & LEVEL_FLAG_OVERLOAD) == 0;
+}
+
+// Converte o valor pico a pico para dB
+unsigned int level_convert_to_db(uint16_t peak_to_peak);
+
+// Leitura exibida e usada pelo alarme. Uma janela com saturação não é reportada:
+// o último nível válido é mantido e a leitura é marcada como inválida.
+typedef struct {
+  uint16_t peak_to_peak;
+  unsigned int db;
+  unsigned int flags; // LEVEL_FLAG_* da última janela
+  bool valid;
+} level_reading_t;
+
+void level_reading_update(level_reading_t *r, const level_window_t *w);
+
+// Piso de ruído: menor pico a pico recente, em ponto fixo (Q8). Cai na hora
+// para uma janela mais silenciosa e sobe devagar (1/LEVEL_NOISE_RISE por janela),
+// assim ruídos momentâneos não o elevam. Deve receber apenas janelas válidas.
+#define LEVEL_NOISE_RISE 64
+
+typedef struct {
+  uint32_t floor_q8;
+  uint32_t windows; // janelas válidas consideradas
+} level_noise_t;
+
+void level_noise_reset(level_noise_t *n);
+void level_noise_update(level_noise_t *n, uint16_t peak_to_peak);
+
+// Piso de ruído, em passos do ADC (pico a pico)
+uint16_t level_noise_floor(const level_noise_t *n);
+
+// Faixa dinâmica efetiva: do piso de ruído ao fundo de escala do ADC, em dB
+unsigned int level_dynamic_range_db(const level_noise_t *n);
+
+// Indica se o alarme (matriz de LEDs) deve ser acionado
+static inline bool level_alarm(unsigned int db_value, unsigned int db_boundary, bool enabled) {
+  return enabled && db_value > db_boundary;
+}
+
+// Margem acima do limite a partir da qual o alarme é considerado crítico
+#define LEVEL_CRITICAL_MARGIN_DB 10
+
+typedef enum {
+  LEVEL_ALARM_NONE = 0,
+  LEVEL_ALARM_ABOVE,
+  LEVEL_ALARM_CRITICAL
+} level_alarm_level_t;
+
+// Classifica o alarme e, em *amount, informa o quanto a medição passou do limite (0 a 255).
+// Com o ADC saturado o nível real é desconhecido, mas certamente alto: o alarme é crítico.
+static inline level_alarm_level_t level_alarm_level(const level_reading_t *r, unsigned int db_boundary, bool enabled, uint8_t *amount) {
+  unsigned int db_value = r->db;
+
+  *amount = 0;
+  if (enabled && (r->flags & LEVEL_FLAG_OVERLOAD)) {
+    *amount = 255;
+    return LEVEL_ALARM_CRITICAL;
+  }
+  if (!level_alarm(db_value, db_boundary, enabled))
+    return LEVEL_ALARM_NONE;
+
+  unsigned int excess = db_value - db_boundary;
+  if (excess >= LEVEL_CRITICAL_MARGIN_DB) {
+    *amount = 255;
+    return LEVEL_ALARM_CRITICAL;
+  }
+  *amount = (uint8_t)(excess * 255 / LEVEL_CRITICAL_MARGIN_DB);
+  return LEVEL_ALARM_ABOVE;
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef __RECORDER_INC
+#define __RECORDER_INC
+
+// Gravação das janelas de medição para replay no computador (tools/replay).
+// Habilitada com a opção DECIMETER_RECORD do CMake. Sem ela, as funções são vazias.
+//
+// Cada janela é enviada pela serial, após a medição, no formato:
+//   @R w <t_us> <limite_db> <led>   início da janela e configuração vigente
+//   @R s <adc>                      amostra, na ordem da leitura
+//   @R e <dt_us> <n> <perdidas>     fim da janela (dt relativo ao início)
+//
+// A gravação não altera a medição: a janela tem sempre a duração configurada.
+// A memória comporta RECORDER_MAX_SAMPLES amostras (cerca de 80 ms com o ADC
+// lido a ~300 mil amostras/s); janelas mais longas, até CONFIG_WINDOW_MAX_MS,
+// não caberiam na RAM do RP2040. As amostras além da memória são contadas em
+// <perdidas> e a janela fica marcada como truncada: o replay a rejeita, pois não
+// poderia reproduzir o nível medido. Para gravar, use janelas de até ~80 ms.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef DECIMETER_RECORD
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+
+// Quantidade máxima de amostras gravadas por janela (2 bytes cada)
+#ifndef RECORDER_MAX_SAMPLES
+#define RECORDER_MAX_SAMPLES 24576
+#endif
+
+static uint64_t recorder_start_us;
+static uint16_t recorder_samples[RECORDER_MAX_SAMPLES];
+static uint32_t recorder_count;
+static uint32_t recorder_dropped;
+
+// Inicia a gravação de uma janela
+static inline void recorder_begin(void) {
+  recorder_count = 0;
+  recorder_dropped = 0;
+  recorder_start_us = time_us_64();
+}
+
+// Armazena uma amostra na memória (a impressão fica para o fim da janela).
+// Com a memória cheia a amostra é apenas contada como perdida.
+static inline void recorder_sample(uint16_t sample) {
+  if (recorder_count == RECORDER_MAX_SAMPLES) {
+    recorder_dropped++;
+    return;
+  }
+
+  recorder_samples[recorder_count++] = sample;
+}
+
+// Envia a janela gravada pela serial
+static inline void recorder_end(unsigned int db_boundary, bool led_enabled) {
+  uint32_t end = (uint32_t)(time_us_64() - recorder_start_us);
+
+  printf("@R w %llu %u %u\n", (unsigned long long)recorder_start_us, db_boundary, led_enabled ? 1u : 0u);
+  for (uint32_t i = 0; i < recorder_count; ++i)
+    printf("@R s %u\n", recorder_samples[i]);
+  printf("@R e %lu %lu %lu\n", (unsigned long)end, (unsigned long)recorder_count, (unsigned long)recorder_dropped);
+}
+
+#else
+
+static inline void recorder_begin(void) {}
+static inline void recorder_sample(uint16_t sample) { (void)sample; }
+static inline void recorder_end(unsigned int db_boundary, bool led_enabled) { (void)db_boundary; (void)led_enabled; }
+
+#endif
+
+#endif
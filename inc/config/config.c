@@ -0,0 +1,235 @@
+#include <stdio.h>
+#include <string.h>
+#include "inc/config/config.h"
+
+const config_values_t config_defaults = {
+  .db_boundary = 60,
+  .sample_window_ms = 50, // 50 ms = 20 Hz
+  .brightness = 0xFF,
+  .led_enabled = 1,
+};
+
+// Posição do CRC em um registro com length bytes de valores
+#define CONFIG_RECORD_HEADER offsetof(config_record_t, values)
+
+uint32_t config_crc32(const void *data, size_t len) {
+  const uint8_t *p = data;
+  uint32_t crc = 0xFFFFFFFFu;
+
+  while (len--) {
+    crc ^= *p++;
+    for (int k = 0; k < 8; ++k)
+      crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1u));
+  }
+  return ~crc;
+}
+
+void config_sanitize(config_values_t *v) {
+  if (v->db_boundary > CONFIG_DB_MAX)
+    v->db_boundary = CONFIG_DB_MAX;
+  if (v->sample_window_ms < CONFIG_WINDOW_MIN_MS)
+    v->sample_window_ms = CONFIG_WINDOW_MIN_MS;
+  if (v->sample_window_ms > CONFIG_WINDOW_MAX_MS)
+    v->sample_window_ms = CONFIG_WINDOW_MAX_MS;
+  if (v->brightness < CONFIG_BRIGHTNESS_MIN)
+    v->brightness = CONFIG_BRIGHTNESS_MIN;
+  v->led_enabled = v->led_enabled != 0;
+  memset(v->reserved, 0, sizeof(v->reserved));
+}
+
+// Cópia consistente dos valores; retorna a sequência correspondente
+static uint32_t config_snapshot(const config_store_t *s, config_values_t *out) {
+  uint32_t before, after;
+
+  do {
+    before = atomic_load_explicit(&s->seq, memory_order_acquire);
+    memcpy(out, &s->values, sizeof(*out));
+    atomic_thread_fence(memory_order_acquire);
+    after = atomic_load_explicit(&s->seq, memory_order_relaxed);
+  } while ((before & 1u) || before != after);
+
+  return before;
+}
+
+void config_read(const config_store_t *s, config_values_t *out) {
+  config_snapshot(s, out);
+}
+
+void config_write(config_store_t *s, const config_values_t *values) {
+  config_values_t v = *values;
+  uint32_t seq = atomic_load_explicit(&s->seq, memory_order_relaxed);
+
+  config_sanitize(&v);
+  atomic_store_explicit(&s->seq, seq + 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  memcpy(&s->values, &v, sizeof(v));
+  atomic_store_explicit(&s->seq, seq + 2, memory_order_release);
+}
+
+// Lê o registro da página e valida magic, versão, tamanho e CRC
+static bool config_load_record(const config_backend_t *b, uint32_t page, const config_values_t *defaults,
+                               config_values_t *values, uint32_t *sequence) {
+  uint8_t buf[sizeof(config_record_t)];
+  config_record_t header;
+  uint32_t crc;
+
+  b->read(b->ctx, page * b->page_size, buf, sizeof(buf));
+  memcpy(&header, buf, CONFIG_RECORD_HEADER);
+
+  if (header.magic != CONFIG_MAGIC || header.version == 0 || header.version > CONFIG_VERSION)
+    return false;
+  if (header.length == 0 || header.length > sizeof(config_values_t))
+    return false;
+
+  memcpy(&crc, buf + CONFIG_RECORD_HEADER + header.length, sizeof(crc));
+  if (config_crc32(buf, CONFIG_RECORD_HEADER + header.length) != crc)
+    return false;
+
+  // Registros de versões anteriores são completados com os valores padrão
+  *values = *defaults;
+  memcpy(values, buf + CONFIG_RECORD_HEADER, header.length);
+  config_sanitize(values);
+  *sequence = header.sequence;
+  return true;
+}
+
+static bool config_page_blank(const config_backend_t *b, uint32_t page) {
+  uint8_t buf[sizeof(config_record_t)];
+
+  b->read(b->ctx, page * b->page_size, buf, sizeof(buf));
+  for (size_t i = 0; i < sizeof(buf); ++i) {
+    if (buf[i] != 0xFF)
+      return false;
+  }
+  return true;
+}
+
+bool config_init(config_store_t *s, const config_backend_t *backend, const config_values_t *defaults) {
+  uint32_t pages = backend->size / backend->page_size;
+  uint32_t best_page = 0;
+  bool found = false;
+  config_values_t values = *defaults;
+
+  memset(s, 0, sizeof(*s));
+  s->backend = backend;
+  s->save_delay_ms = CONFIG_SAVE_DELAY_MS;
+
+  for (uint32_t page = 0; page < pages; ++page) {
+    config_values_t v;
+    uint32_t sequence;
+
+    if (!config_load_record(backend, page, defaults, &v, &sequence))
+      continue;
+    // Comparação com sinal: a sequência pode dar a volta
+    if (!found || (int32_t)(sequence - s->record_sequence) > 0) {
+      found = true;
+      values = v;
+      best_page = page;
+      s->record_sequence = sequence;
+    }
+  }
+
+  // A próxima gravação vai para a página seguinte, se ainda estiver apagada.
+  // Caso contrário o setor é apagado antes da gravação.
+  s->next_page = found ? best_page + 1 : 0;
+  if (s->next_page < pages && !config_page_blank(backend, s->next_page))
+    s->next_page = pages;
+
+  config_sanitize(&values);
+  s->values = values;
+  atomic_store_explicit(&s->seq, 0, memory_order_release);
+  s->saved_seq = 0;
+  s->seen_seq = 0;
+  return found;
+}
+
+static bool config_save(config_store_t *s, const config_values_t *values) {
+  const config_backend_t *b = s->backend;
+  uint32_t pages = b->size / b->page_size;
+  config_record_t record = {
+    .magic = CONFIG_MAGIC,
+    .version = CONFIG_VERSION,
+    .length = sizeof(config_values_t),
+    .sequence = s->record_sequence + 1,
+    .values = *values,
+  };
+  config_record_t check;
+
+  record.crc = config_crc32(&record, offsetof(config_record_t, crc));
+
+  if (s->next_page >= pages) {
+    if (!b->erase(b->ctx))
+      return false;
+    s->erases++;
+    s->next_page = 0;
+  }
+
+  // A página é consumida mesmo se a gravação falhar
+  uint32_t offset = s->next_page++ * b->page_size;
+  if (!b->program(b->ctx, offset, &record, sizeof(record)))
+    return false;
+
+  b->read(b->ctx, offset, &check, sizeof(check));
+  if (memcmp(&check, &record, sizeof(record)) != 0)
+    return false;
+
+  s->record_sequence = record.sequence;
+  s->saves++;
+  return true;
+}
+
+config_service_result_t config_service(config_store_t *s, uint32_t now_ms) {
+  uint32_t seq = atomic_load_explicit(&s->seq, memory_order_acquire);
+
+  if ((seq & 1u) || seq == s->saved_seq)
+    return CONFIG_IDLE;
+
+  // Cada alteração reinicia a espera: ajustes em sequência geram uma só gravação
+  if (seq != s->seen_seq) {
+    s->seen_seq = seq;
+    s->changed_ms = now_ms;
+    return CONFIG_IDLE;
+  }
+  if (now_ms - s->changed_ms < s->save_delay_ms)
+    return CONFIG_IDLE;
+
+  config_values_t values;
+  seq = config_snapshot(s, &values);
+
+  if (!config_save(s, &values)) {
+    s->failures++;
+    s->changed_ms = now_ms;
+    return CONFIG_FAILED;
+  }
+
+  s->saved_seq = seq;
+  return CONFIG_SAVED;
+}
+
+bool config_set_field(config_values_t *v, const char *name, long value) {
+  if (value < 0)
+    value = 0;
+  if (value > UINT16_MAX)
+    value = UINT16_MAX;
+
+  if (strcmp(name, "limite") == 0) {
+    v->db_boundary = (uint16_t)value;
+  } else if (strcmp(name, "led") == 0) {
+    v->led_enabled = value != 0;
+  } else if (strcmp(name, "janela") == 0) {
+    v->sample_window_ms = (uint16_t)value;
+  } else if (strcmp(name, "brilho") == 0) {
+    v->brightness = value > UINT8_MAX ? UINT8_MAX : (uint8_t)value;
+  } else {
+    return false;
+  }
+
+  config_sanitize(v);
+  return true;
+}
+
+size_t config_format(const config_values_t *v, char *buf, size_t len) {
+  int n = snprintf(buf, len, "limite=%u led=%u janela=%u brilho=%u", v->db_boundary, v->led_enabled,
+                   v->sample_window_ms, v->brightness);
+  return n < 0 ? 0 : (size_t)n;
+}
@@ -0,0 +1,118 @@
+#ifndef __CONFIG_INC
+#define __CONFIG_INC
+
+// Configurações ajustáveis em campo (limite do alarme, LEDs, janela de medição e
+// brilho), com leitura sem bloqueio e persistência na flash.
+//
+// Leitura: os valores são protegidos por um contador de sequência (seqlock). Quem
+// lê copia os valores e repete a cópia se uma escrita ocorreu no meio; nunca
+// espera por uma escrita na flash, que só acontece em config_service().
+// Escrita: apenas em RAM e por um escritor de cada vez (no firmware, a interrupção
+// dos botões; escritas fora dela devem ser feitas com as interrupções desligadas).
+// Persistência: config_service() grava os valores quando ficam sem alteração por
+// save_delay_ms, juntando uma sequência de ajustes em uma única gravação. Cada
+// registro tem versão e CRC32; os registros são gravados em páginas sucessivas de
+// um setor e o setor só é apagado quando todas as páginas foram usadas.
+//
+// Não depende do SDK do Pico: o armazenamento é informado por um config_backend_t.
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Versão do formato de config_values_t. Campos novos são sempre acrescentados ao
+// final; registros de versões anteriores são completados com os valores padrão.
+#define CONFIG_VERSION 1
+#define CONFIG_MAGIC 0x47464344u // "DCFG"
+
+// Limites aceitos para cada campo
+#define CONFIG_DB_MIN 0
+#define CONFIG_DB_MAX 150
+#define CONFIG_WINDOW_MIN_MS 10
+#define CONFIG_WINDOW_MAX_MS 500
+#define CONFIG_BRIGHTNESS_MIN 1
+
+typedef struct {
+  uint16_t db_boundary;      // limite do alarme, em dB
+  uint16_t sample_window_ms; // janela de medição
+  uint8_t brightness;        // contraste do display em uso normal
+  uint8_t led_enabled;       // alarme na matriz de LEDs (0 ou 1)
+  uint8_t reserved[2];
+} config_values_t;
+
+// Valores usados pelo firmware quando não há registro válido
+extern const config_values_t config_defaults;
+
+// Armazenamento não volátil: size bytes divididos em páginas de page_size bytes,
+// apagados de uma só vez por erase(). program() grava até page_size bytes no
+// início de uma página apagada.
+typedef struct {
+  uint32_t size;
+  uint32_t page_size;
+  void (*read)(void *ctx, uint32_t offset, void *dst, size_t len);
+  bool (*program)(void *ctx, uint32_t offset, const void *src, size_t len);
+  bool (*erase)(void *ctx);
+  void *ctx;
+} config_backend_t;
+
+// Registro gravado em cada página
+typedef struct {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t length;   // bytes de values válidos para a versão gravada
+  uint32_t sequence; // maior sequência = registro mais recente
+  config_values_t values;
+  uint32_t crc;      // CRC32 de todos os campos anteriores
+} config_record_t;
+
+typedef struct {
+  _Atomic uint32_t seq; // ímpar durante uma escrita
+  config_values_t values;
+
+  const config_backend_t *backend;
+  uint32_t save_delay_ms;
+  uint32_t saved_seq;   // seq dos valores gravados na flash
+  uint32_t seen_seq;    // seq observado pela última chamada de config_service()
+  uint32_t changed_ms;  // instante em que seen_seq mudou
+  uint32_t record_sequence;
+  uint32_t next_page;
+  uint32_t saves, erases, failures;
+} config_store_t;
+
+// Tempo sem alterações antes de gravar
+#define CONFIG_SAVE_DELAY_MS 3000
+
+// Carrega o registro mais recente do armazenamento (ou defaults, se não houver
+// nenhum válido). Retorna true se um registro foi carregado.
+bool config_init(config_store_t *s, const config_backend_t *backend, const config_values_t *defaults);
+
+// Cópia consistente dos valores atuais. Pode ser chamada de qualquer núcleo.
+void config_read(const config_store_t *s, config_values_t *out);
+
+// Substitui os valores (ajustados aos limites). Escritores devem ser serializados.
+void config_write(config_store_t *s, const config_values_t *values);
+
+typedef enum {
+  CONFIG_IDLE,  // nada a gravar
+  CONFIG_SAVED, // valores gravados
+  CONFIG_FAILED // falha na gravação; nova tentativa após save_delay_ms
+} config_service_result_t;
+
+// Grava os valores quando estiverem estáveis. Chamada pelo laço principal.
+config_service_result_t config_service(config_store_t *s, uint32_t now_ms);
+
+// Ajusta os campos aos limites aceitos
+void config_sanitize(config_values_t *v);
+
+// Altera um campo pelo nome ("limite", "led", "janela" ou "brilho").
+// Retorna false se o nome não existir.
+bool config_set_field(config_values_t *v, const char *name, long value);
+
+// Texto "limite=60 led=1 janela=50 brilho=255"
+size_t config_format(const config_values_t *v, char *buf, size_t len);
+
+// CRC32 (polinômio 0xEDB88320, o mesmo do zlib)
+uint32_t config_crc32(const void *data, size_t len);
+
+#endif
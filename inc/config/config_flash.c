@@ -0,0 +1,76 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "inc/config/config_flash.h"
+
+// Último setor da flash, fora da área ocupada pelo programa
+#define CONFIG_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+
+typedef struct {
+  uint32_t offset;
+  const uint8_t *page;
+} config_flash_program_t;
+
+// Página completa gravada pela flash_range_program (o restante fica em 0xFF)
+static uint8_t config_flash_page[FLASH_PAGE_SIZE];
+
+static const config_flash_hooks_t *config_flash_hooks;
+
+void config_flash_set_hooks(const config_flash_hooks_t *hooks) {
+  config_flash_hooks = hooks;
+}
+
+static void config_flash_read(void *ctx, uint32_t offset, void *dst, size_t len) {
+  (void)ctx;
+  memcpy(dst, (const void *)(uintptr_t)(XIP_BASE + CONFIG_FLASH_OFFSET + offset), len);
+}
+
+// Executadas com as interrupções desligadas e o outro núcleo parado (flash_safe_execute)
+static void config_flash_do_program(void *param) {
+  const config_flash_program_t *p = param;
+  flash_range_program(CONFIG_FLASH_OFFSET + p->offset, p->page, FLASH_PAGE_SIZE);
+}
+
+static void config_flash_do_erase(void *param) {
+  (void)param;
+  flash_range_erase(CONFIG_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+}
+
+// Executa a operação com quem lê a flash por DMA parado
+static bool config_flash_execute(void (*func)(void *), void *param) {
+  const config_flash_hooks_t *hooks = config_flash_hooks;
+
+  if (hooks != NULL && hooks->before != NULL)
+    hooks->before(hooks->ctx);
+  bool ok = flash_safe_execute(func, param, CONFIG_FLASH_TIMEOUT_MS) == PICO_OK;
+  if (hooks != NULL && hooks->after != NULL)
+    hooks->after(hooks->ctx);
+  return ok;
+}
+
+static bool config_flash_program(void *ctx, uint32_t offset, const void *src, size_t len) {
+  (void)ctx;
+  if (len > FLASH_PAGE_SIZE)
+    return false;
+
+  memset(config_flash_page, 0xFF, sizeof(config_flash_page));
+  memcpy(config_flash_page, src, len);
+
+  config_flash_program_t p = { offset, config_flash_page };
+  return config_flash_execute(config_flash_do_program, &p);
+}
+
+static bool config_flash_erase(void *ctx) {
+  (void)ctx;
+  return config_flash_execute(config_flash_do_erase, NULL);
+}
+
+const config_backend_t config_flash_backend = {
+  .size = FLASH_SECTOR_SIZE,
+  .page_size = FLASH_PAGE_SIZE,
+  .read = config_flash_read,
+  .program = config_flash_program,
+  .erase = config_flash_erase,
+  .ctx = NULL,
+};
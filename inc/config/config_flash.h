@@ -0,0 +1,25 @@
+#ifndef __CONFIG_FLASH_INC
+#define __CONFIG_FLASH_INC
+
+// Armazenamento das configurações no último setor da flash do Pico.
+
+#include "inc/config/config.h"
+
+// Tempo máximo de espera pelo outro núcleo antes de gravar a flash
+#define CONFIG_FLASH_TIMEOUT_MS 100
+
+extern const config_backend_t config_flash_backend;
+
+// Chamadas antes e depois de cada gravação ou apagamento. Durante a operação a
+// flash não pode ser lida (nem pela XIP): quem a lê por DMA deve parar em before()
+// e aguardar o fim da transferência em andamento.
+typedef struct {
+  void (*before)(void *ctx);
+  void (*after)(void *ctx);
+  void *ctx;
+} config_flash_hooks_t;
+
+// Define as chamadas (NULL remove). hooks deve permanecer válido.
+void config_flash_set_hooks(const config_flash_hooks_t *hooks);
+
+#endif
@@ -3,10 +3,14 @@
 #include "pico/stdlib.h" // inclui a biblioteca padrão do pico para gpios e temporizadores
 #include "hardware/i2c.h" // inclui a biblioteca para utilizar oprotocolo i2c
 #include "inc/ssd1306/ssd1306.h" // inclui a biblioteca com definição das funções para manipulação do display OLED
-#include "inc/ssd1306/font.h" // inclui a biblioteca com as fontes dos caracteres para o display OLED
+#include "inc/audio/level.h" // inclui os indicadores de saturação da medição
 
-// Inicia a estrutura do display OLED
-ssd1306_t ssd;
+// Define os valores para a progress-bar
+#define MAX_DB 150                
+#define PROGRESS_BAR_X 0          
+#define PROGRESS_BAR_Y 20       
+#define PROGRESS_BAR_WIDTH 82 
+#define PROGRESS_BAR_HEIGHT 16
 
 // Configuração do protocolo i2c
 void i2c_setup(i2c_inst_t *id, uint freq, uint sda_pin, uint scl_pin) {
@@ -23,129 +27,199 @@ void i2c_setup(i2c_inst_t *id, uint freq, uint sda_pin, uint scl_pin) {
     gpio_pull_up(scl_pin);
 }
 
-// Configura o display
-void display_setup(uint8_t address, i2c_inst_t *i2c_id){
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+// Configuração do barramento SPI (display conectado por SPI)
+void spi_setup(spi_inst_t *id, uint freq, uint sck_pin, uint mosi_pin) {
+    spi_init(id, freq);
+    gpio_set_function(sck_pin, GPIO_FUNC_SPI);
+    gpio_set_function(mosi_pin, GPIO_FUNC_SPI);
+}
+
+// Configura o display. A instância deve ter sido declarada com SSD1306_DEFINE
+bool display_setup_spi(ssd1306_t *ssd, spi_inst_t *spi_id, uint8_t cs_pin, uint8_t dc_pin){
+    // Inicializa e configura o display
+    if (!ssd1306_init_spi(ssd, WIDTH, HEIGHT, false, spi_id, cs_pin, dc_pin)) {
+        return false;
+    }
+#else
+// Configura o display. A instância deve ter sido declarada com SSD1306_DEFINE
+bool display_setup(ssd1306_t *ssd, uint8_t address, i2c_inst_t *i2c_id){
     // Inicializa e configura o display
-    ssd1306_init(&ssd, WIDTH, HEIGHT, false, address, i2c_id); 
-    ssd1306_config(&ssd); 
-    ssd1306_send_data(&ssd); 
+    if (!ssd1306_init(ssd, WIDTH, HEIGHT, false, address, i2c_id)) {
+        return false;
+    }
+#endif
+    ssd1306_config(ssd); 
+    ssd1306_send_data(ssd); 
 
     // Limpa o buffer e atualiza o display
-    ssd1306_fill(&ssd, false);
-    ssd1306_send_data(&ssd);
+    ssd1306_fill(ssd, false);
+    ssd1306_send_data(ssd);
+
+    return true;
 }
 
 // Desenha o layout principal da GUI
-void display_draw_main_layout() {
+void display_draw_main_layout(ssd1306_t *ssd) {
     // Define o cabeçalho do layout
-    ssd1306_draw_string(&ssd, "Decimeter", 5, 3); 
-    ssd1306_rect(&ssd, 0, 0, 128, 14, true, false);
+    ssd1306_draw_string(ssd, "Decimeter", 5, 3); 
+    ssd1306_rect(ssd, 0, 0, 128, 14, true, false);
 
     // Arredodamento - topo esquerda
-    ssd1306_pixel(&ssd, 1, 1, true);
-    ssd1306_pixel(&ssd, 2, 1, true);
-    ssd1306_pixel(&ssd, 1, 2, true);
+    ssd1306_pixel(ssd, 1, 1, true);
+    ssd1306_pixel(ssd, 2, 1, true);
+    ssd1306_pixel(ssd, 1, 2, true);
 
     // Arredodamento - base esquerda
-    ssd1306_pixel(&ssd, 1, 11, true);
-    ssd1306_pixel(&ssd, 1, 12, true);
-    ssd1306_pixel(&ssd, 2, 12, true);
+    ssd1306_pixel(ssd, 1, 11, true);
+    ssd1306_pixel(ssd, 1, 12, true);
+    ssd1306_pixel(ssd, 2, 12, true);
 
     // Arredodamento - topo direito
-    ssd1306_pixel(&ssd, 125, 1, true);
-    ssd1306_pixel(&ssd, 126, 1, true);
-    ssd1306_pixel(&ssd, 126, 2, true);
+    ssd1306_pixel(ssd, 125, 1, true);
+    ssd1306_pixel(ssd, 126, 1, true);
+    ssd1306_pixel(ssd, 126, 2, true);
 
     // Arredodamento - base direita
-    ssd1306_pixel(&ssd, 126, 11, true);
-    ssd1306_pixel(&ssd, 126, 12, true);
-    ssd1306_pixel(&ssd, 125, 12, true);
+    ssd1306_pixel(ssd, 126, 11, true);
+    ssd1306_pixel(ssd, 126, 12, true);
+    ssd1306_pixel(ssd, 125, 12, true);
 
     // Linha divisório do cabeçalho
-    ssd1306_vline(&ssd, 78, 0, 13, true);
+    ssd1306_vline(ssd, 78, 0, 13, true);
 
     // Arredodamento - topo esquerda
-    ssd1306_pixel(&ssd, 76, 1, true);
-    ssd1306_pixel(&ssd, 77, 1, true);
-    ssd1306_pixel(&ssd, 77, 2, true);
+    ssd1306_pixel(ssd, 76, 1, true);
+    ssd1306_pixel(ssd, 77, 1, true);
+    ssd1306_pixel(ssd, 77, 2, true);
 
     // Arredodamento - base esquerda
-    ssd1306_pixel(&ssd, 76, 12, true);
-    ssd1306_pixel(&ssd, 77, 12, true);
-    ssd1306_pixel(&ssd, 77, 11, true);
+    ssd1306_pixel(ssd, 76, 12, true);
+    ssd1306_pixel(ssd, 77, 12, true);
+    ssd1306_pixel(ssd, 77, 11, true);
 
     // Arredodamento - topo direito
-    ssd1306_pixel(&ssd, 79, 1, true);
-    ssd1306_pixel(&ssd, 79, 2, true);
-    ssd1306_pixel(&ssd, 80, 1, true);
+    ssd1306_pixel(ssd, 79, 1, true);
+    ssd1306_pixel(ssd, 79, 2, true);
+    ssd1306_pixel(ssd, 80, 1, true);
 
     // Arredodamento - base direita
-    ssd1306_pixel(&ssd, 79, 12, true);
-    ssd1306_pixel(&ssd, 79, 11, true);
-    ssd1306_pixel(&ssd, 80, 12, true);
+    ssd1306_pixel(ssd, 79, 12, true);
+    ssd1306_pixel(ssd, 79, 11, true);
+    ssd1306_pixel(ssd, 80, 12, true);
     
     // atualiza o display OLED
-    ssd1306_send_data(&ssd);
+    ssd1306_send_data(ssd);
 }
 
 // Limpa a seção principal da GUI
-void display_clean_main_area() {
-    ssd1306_rect(&ssd, 0, 14, 128, 50, false, true);
+void display_clean_main_area(ssd1306_t *ssd) {
+    ssd1306_rect(ssd, 0, 14, 128, 50, false, true);
 }
 
 // Insere a seta para a esquerda na GUI
-void display_draw_left_arrow() {
-    ssd1306_vline(&ssd, 11, 34, 41, true);
-    ssd1306_vline(&ssd, 10, 35, 40, true);
-    ssd1306_vline(&ssd, 9, 36, 39, true);
-    ssd1306_vline(&ssd, 8, 37, 38, true);
+void display_draw_left_arrow(ssd1306_t *ssd) {
+    ssd1306_vline(ssd, 11, 34, 41, true);
+    ssd1306_vline(ssd, 10, 35, 40, true);
+    ssd1306_vline(ssd, 9, 36, 39, true);
+    ssd1306_vline(ssd, 8, 37, 38, true);
 }
 
 // Insere a seta para a direita na GUI
-void display_draw_right_arrow() {
-    ssd1306_vline(&ssd, 114, 34, 41, true);
-    ssd1306_vline(&ssd, 115, 35, 40, true);
-    ssd1306_vline(&ssd, 116, 36, 39, true);
-    ssd1306_vline(&ssd, 117, 37, 38, true);
+void display_draw_right_arrow(ssd1306_t *ssd) {
+    ssd1306_vline(ssd, 114, 34, 41, true);
+    ssd1306_vline(ssd, 115, 35, 40, true);
+    ssd1306_vline(ssd, 116, 36, 39, true);
+    ssd1306_vline(ssd, 117, 37, 38, true);
 }
 
 // Insere o botão de incremento na GUI
-void display_draw_plus_btn() {
+void display_draw_plus_btn(ssd1306_t *ssd) {
     // Desenha o botão
-    ssd1306_rect(&ssd, 105, 28, 16, 16, true, true);
+    ssd1306_rect(ssd, 105, 28, 16, 16, true, true);
 
    // Desenha o sinal de mais
    // Eixo x
-    ssd1306_vline(&ssd, 112, 30, 41, false);
-    ssd1306_vline(&ssd, 113, 30, 41, false);
+    ssd1306_vline(ssd, 112, 30, 41, false);
+    ssd1306_vline(ssd, 113, 30, 41, false);
    // Eixo y
-    ssd1306_hline(&ssd, 107, 118, 35, false);
-    ssd1306_hline(&ssd, 107, 118, 36, false);
+    ssd1306_hline(ssd, 107, 118, 35, false);
+    ssd1306_hline(ssd, 107, 118, 36, false);
 }
 
 // Insere o botão de decremento na GUI
-void display_draw_minus_btn() {
+void display_draw_minus_btn(ssd1306_t *ssd) {
     // Desenha botão
-    ssd1306_rect(&ssd, 11, 28, 16, 16, true, true);
+    ssd1306_rect(ssd, 11, 28, 16, 16, true, true);
     // Desenha o sinal de menos
-    ssd1306_hline(&ssd, 13, 24, 35, false);
-    ssd1306_hline(&ssd, 13, 24, 36, false);
+    ssd1306_hline(ssd, 13, 24, 35, false);
+    ssd1306_hline(ssd, 13, 24, 36, false);
 }
 
 // Insere a caixa que representa o estado do LED na GUI
-void display_draw_led_on_btn(bool btn_state) {
+void display_draw_led_on_btn(ssd1306_t *ssd, bool btn_state) {
     // Desenha caixa de estado
-    ssd1306_rect(&ssd, 108, 28, 16, 16, true, btn_state);
+    ssd1306_rect(ssd, 108, 28, 16, 16, true, btn_state);
 }
 
 // Desenha o botão de retorno na GUI
-void display_draw_back_arrow() {
+void display_draw_back_arrow(ssd1306_t *ssd) {
     // Desenha o sinal de retorno
-    ssd1306_vline(&ssd, 92, 54, 61, true);
-    ssd1306_vline(&ssd, 91, 55, 60, true);
-    ssd1306_vline(&ssd, 90, 56, 59, true);
-    ssd1306_vline(&ssd, 89, 57, 58, true);
+    ssd1306_vline(ssd, 92, 54, 61, true);
+    ssd1306_vline(ssd, 91, 55, 60, true);
+    ssd1306_vline(ssd, 90, 56, 59, true);
+    ssd1306_vline(ssd, 89, 57, 58, true);
+
+    ssd1306_draw_string(ssd, "vltr", 95, 54);
+}
+
+// Atualiza o valor limite, em dB, exibido no cabeçalho
+void display_draw_header_level(ssd1306_t *ssd, uint db_boundary) {
+    char db_string[10];
+
+    ssd1306_rect(ssd, 79, 1, 45, 11, false, true);
+    snprintf(db_string, sizeof(db_string), "%udB", db_boundary);
+    ssd1306_draw_string(ssd, db_string, 83, 3);
+}
 
-    ssd1306_draw_string(&ssd, "vltr", 95, 54);
+// Atualiza a barra de progresso
+void display_draw_progress_bar(ssd1306_t *ssd, uint db_value) {
+     // Limita o valor máximo
+    if (db_value > MAX_DB) { 
+        db_value = MAX_DB;
+    }
+
+    // Determina o comprimento da barra que estará preenchida
+    uint filled_width = (db_value * PROGRESS_BAR_WIDTH) / MAX_DB;
+
+    // Desenha o contorno da barra de progresso na tela de visualização
+    ssd1306_rect(ssd, PROGRESS_BAR_X, PROGRESS_BAR_Y, PROGRESS_BAR_WIDTH, PROGRESS_BAR_HEIGHT, true, false);
+
+    // Desenha a parte preenchida de acordo com a intensidade atual
+    ssd1306_rect(ssd, PROGRESS_BAR_X, PROGRESS_BAR_Y, filled_width, PROGRESS_BAR_HEIGHT, true, true);
 }
 
+// Desenha a página de visualização: botão de voltar, barra de progresso e valor medido (dB).
+// Com o ADC saturado a leitura é inválida: a barra fica cheia e o valor dá lugar a "SAT".
+// Com o sinal abaixo da resolução do ADC o valor dá lugar a "BAIXO".
+void display_draw_measurement(ssd1306_t *ssd, uint db_value, uint flags) {
+    char db_measured_string[10];
+
+    display_draw_back_arrow(ssd);
+
+    if (flags & LEVEL_FLAG_OVERLOAD) {
+        display_draw_progress_bar(ssd, MAX_DB);
+        ssd1306_draw_string(ssd, "SAT", 84, 25);
+        return;
+    }
+
+    display_draw_progress_bar(ssd, db_value);
+
+    if (flags & LEVEL_FLAG_UNDERRANGE) {
+        ssd1306_draw_string(ssd, "BAIXO", 84, 25);
+        return;
+    }
+
+    snprintf(db_measured_string, sizeof(db_measured_string), "%udB", db_value);
+    ssd1306_draw_string(ssd, db_measured_string, 84, 25); 
+}
@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <string.h>
+#include "inc/display/mirror.h"
+
+static const char mirror_b64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void mirror_init(mirror_t *m, uint8_t width, uint8_t height, uint32_t interval_ms, uint16_t keyframe_every) {
+  memset(m, 0, sizeof(*m));
+  m->width = width;
+  m->height = height;
+  m->frame_len = (size_t)width * (height / 8U);
+  if (m->frame_len > MIRROR_MAX_FRAME)
+    m->frame_len = MIRROR_MAX_FRAME;
+  m->interval_ms = interval_ms;
+  m->keyframe_every = keyframe_every;
+  m->since_keyframe = keyframe_every; // o primeiro quadro é chave
+}
+
+bool mirror_capture(mirror_t *m, const uint8_t *framebuffer, uint8_t screen, uint32_t now_ms) {
+  if (m->pending_ready || now_ms - m->last_capture_ms < m->interval_ms)
+    return false;
+
+  memcpy(m->pending, framebuffer, m->frame_len);
+  m->pending_screen = screen;
+  m->last_capture_ms = now_ms;
+  m->pending_ready = true;
+  return true;
+}
+
+void mirror_request_keyframe(mirror_t *m) {
+  m->since_keyframe = m->keyframe_every;
+}
+
+size_t mirror_rle_encode(const uint8_t *current, const uint8_t *previous, size_t len, uint8_t *out) {
+#define MIRROR_DELTA(k) ((uint8_t)(current[k] ^ (previous ? previous[k] : 0)))
+  size_t i = 0, o = 0;
+
+  while (i < len) {
+    size_t n = 0;
+
+    if (MIRROR_DELTA(i) == 0) {
+      while (i < len && n < 128 && MIRROR_DELTA(i) == 0) {
+        ++i;
+        ++n;
+      }
+      out[o++] = (uint8_t)(0x80 | (n - 1));
+    } else {
+      // Um zero isolado fica dentro do trecho literal (custa menos que um novo controle)
+      size_t start = i;
+      while (i < len && n < 128 && (MIRROR_DELTA(i) != 0 || (i + 1 < len && MIRROR_DELTA(i + 1) != 0))) {
+        ++i;
+        ++n;
+      }
+      out[o++] = (uint8_t)(n - 1);
+      for (size_t k = start; k < start + n; ++k)
+        out[o++] = MIRROR_DELTA(k);
+    }
+  }
+
+  return o;
+#undef MIRROR_DELTA
+}
+
+int mirror_rle_apply(const uint8_t *in, size_t in_len, uint8_t *frame, size_t frame_len) {
+  size_t i = 0, pos = 0;
+
+  while (i < in_len) {
+    uint8_t c = in[i++];
+    size_t n = (size_t)(c & 0x7F) + 1;
+
+    if (pos + n > frame_len)
+      return -1;
+
+    if (c & 0x80) {
+      pos += n;
+    } else {
+      if (i + n > in_len)
+        return -1;
+      for (size_t k = 0; k < n; ++k)
+        frame[pos++] ^= in[i++];
+    }
+  }
+
+  return pos == frame_len ? 0 : -1;
+}
+
+size_t mirror_base64_encode(const uint8_t *in, size_t len, char *out) {
+  size_t o = 0;
+
+  for (size_t i = 0; i < len; i += 3) {
+    uint32_t v = (uint32_t)in[i] << 16;
+    if (i + 1 < len)
+      v |= (uint32_t)in[i + 1] << 8;
+    if (i + 2 < len)
+      v |= in[i + 2];
+
+    out[o++] = mirror_b64[(v >> 18) & 0x3F];
+    out[o++] = mirror_b64[(v >> 12) & 0x3F];
+    out[o++] = i + 1 < len ? mirror_b64[(v >> 6) & 0x3F] : '=';
+    out[o++] = i + 2 < len ? mirror_b64[v & 0x3F] : '=';
+  }
+
+  return o;
+}
+
+static int mirror_b64_value(char c) {
+  if (c >= 'A' && c <= 'Z')
+    return c - 'A';
+  if (c >= 'a' && c <= 'z')
+    return c - 'a' + 26;
+  if (c >= '0' && c <= '9')
+    return c - '0' + 52;
+  if (c == '+')
+    return 62;
+  if (c == '/')
+    return 63;
+  return -1;
+}
+
+long mirror_base64_decode(const char *in, size_t len, uint8_t *out, size_t cap) {
+  size_t o = 0;
+
+  if (len % 4 != 0)
+    return -1;
+
+  for (size_t i = 0; i < len; i += 4) {
+    int v[4];
+    int pad = 0;
+
+    for (int k = 0; k < 4; ++k) {
+      if (in[i + k] == '=' && i + 4 == len && k >= 2) {
+        v[k] = 0;
+        pad++;
+      } else if ((v[k] = mirror_b64_value(in[i + k])) < 0 || pad) {
+        return -1;
+      }
+    }
+
+    uint32_t bits = ((uint32_t)v[0] << 18) | ((uint32_t)v[1] << 12) | ((uint32_t)v[2] << 6) | (uint32_t)v[3];
+    size_t n = 3 - (size_t)pad;
+    if (o + n > cap)
+      return -1;
+    out[o++] = (uint8_t)(bits >> 16);
+    if (n > 1)
+      out[o++] = (uint8_t)(bits >> 8);
+    if (n > 2)
+      out[o++] = (uint8_t)bits;
+  }
+
+  return (long)o;
+}
+
+size_t mirror_encode(mirror_t *m, char *line, size_t cap) {
+  static uint8_t encoded[MIRROR_MAX_ENCODED];
+
+  if (!m->pending_ready)
+    return 0;
+
+  bool key = m->since_keyframe >= m->keyframe_every;
+  size_t enc_len;
+
+  if (!key && memcmp(m->pending, m->shadow, m->frame_len) == 0) {
+    // Quadro igual ao último espelhado: nada a enviar
+    m->pending_ready = false;
+    return 0;
+  }
+
+  enc_len = mirror_rle_encode(m->pending, key ? NULL : m->shadow, m->frame_len, encoded);
+  m->pending_ready = false;
+
+  // Linha que não cabe é descartada sem alterar o estado: o próximo quadro é
+  // codificado em relação ao último que o visualizador recebeu
+  int head = snprintf(line, cap, "@FB %u %u %c %u %u ", m->seq, m->pending_screen, key ? 'k' : 'd', m->width, m->height);
+  if (head < 0 || (size_t)head + 4 * ((enc_len + 2) / 3) + 2 > cap)
+    return 0;
+
+  memcpy(m->shadow, m->pending, m->frame_len);
+  m->since_keyframe = key ? 1 : m->since_keyframe + 1;
+  m->seq++;
+
+  size_t n = (size_t)head + mirror_base64_encode(encoded, enc_len, line + head);
+  line[n++] = '\n';
+  line[n] = '\0';
+  return n;
+}
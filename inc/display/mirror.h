@@ -0,0 +1,69 @@
+#ifndef __MIRROR_INC
+#define __MIRROR_INC
+
+// Espelhamento do framebuffer do display para um visualizador no computador.
+//
+// A cada intervalo, o quadro enviado ao display é copiado (mirror_capture) e,
+// fora do caminho de desenho, codificado (mirror_encode) como o XOR com o último
+// quadro espelhado, compactado por RLE. Periodicamente é enviado um quadro chave
+// (XOR com um quadro apagado) para que o visualizador possa entrar a qualquer momento.
+//
+// RLE: byte de controle c seguido de dados
+//   c <  0x80: c + 1 bytes literais
+//   c >= 0x80: (c & 0x7F) + 1 bytes zero
+//
+// Linha de texto enviada pela serial (tools/fbviewer):
+//   @FB <seq> <tela> <k|d> <largura> <altura> <base64>
+// Não depende do SDK do Pico.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Maior quadro suportado (128x64, 1 bit por pixel)
+#define MIRROR_MAX_FRAME 1024
+// Maior quadro codificado (pior caso do RLE)
+#define MIRROR_MAX_ENCODED (MIRROR_MAX_FRAME + MIRROR_MAX_FRAME / 128 + 2)
+// Maior linha de texto, incluindo o terminador
+#define MIRROR_MAX_LINE (48 + 4 * ((MIRROR_MAX_ENCODED + 2) / 3) + 2)
+
+typedef struct {
+  uint8_t shadow[MIRROR_MAX_FRAME];  // último quadro espelhado
+  uint8_t pending[MIRROR_MAX_FRAME]; // quadro capturado aguardando envio
+  size_t frame_len;
+  uint8_t width, height;
+  uint8_t pending_screen;
+  volatile bool pending_ready;
+  uint32_t interval_ms;
+  uint32_t last_capture_ms;
+  uint16_t keyframe_every; // quadros entre quadros chave
+  uint16_t since_keyframe;
+  uint16_t seq;
+} mirror_t;
+
+void mirror_init(mirror_t *m, uint8_t width, uint8_t height, uint32_t interval_ms, uint16_t keyframe_every);
+
+// Copia o quadro se o intervalo já passou e não há outro aguardando envio.
+// Apenas uma cópia de memória: pode ser chamada logo após o envio ao display.
+bool mirror_capture(mirror_t *m, const uint8_t *framebuffer, uint8_t screen, uint32_t now_ms);
+
+// Codifica o quadro pendente e monta a linha de texto em line (MIRROR_MAX_LINE bytes).
+// Retorna o tamanho da linha ou 0 se não há nada a enviar (sem quadro, sem mudança
+// ou linha maior que cap; nesse caso o quadro é descartado).
+size_t mirror_encode(mirror_t *m, char *line, size_t cap);
+
+// Faz do próximo quadro um quadro chave. Usada quando uma linha já codificada não
+// chegou ao visualizador (os quadros seguintes seriam relativos a ela).
+void mirror_request_keyframe(mirror_t *m);
+
+// Codificação RLE de (current XOR previous). previous pode ser NULL (quadro chave).
+size_t mirror_rle_encode(const uint8_t *current, const uint8_t *previous, size_t len, uint8_t *out);
+
+// Aplica (XOR) um quadro codificado sobre frame. Retorna 0 ou -1 se os dados forem inválidos.
+int mirror_rle_apply(const uint8_t *in, size_t in_len, uint8_t *frame, size_t frame_len);
+
+// Base64 (RFC 4648). A decodificação retorna o tamanho ou -1 se inválido.
+size_t mirror_base64_encode(const uint8_t *in, size_t len, char *out);
+long mirror_base64_decode(const char *in, size_t len, uint8_t *out, size_t cap);
+
+#endif
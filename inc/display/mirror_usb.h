@@ -0,0 +1,164 @@
+#ifndef __MIRROR_USB_INC
+#define __MIRROR_USB_INC
+
+// Saída USB do espelhamento do display (DECIMETER_MIRROR).
+//
+// As linhas "@FB" têm até ~1,4 kB, mais que a FIFO de transmissão do CDC. Enviá-las
+// com stdio_usb.out_chars() bloquearia o laço enquanto o computador não lê (até
+// PICO_STDIO_USB_STDOUT_TIMEOUT_US) e um printf feito por uma interrupção no meio
+// do envio seria misturado à linha.
+//
+// Por isso a saída de texto (printf) passa por um driver de stdio próprio que só
+// coloca o texto em uma fila, e mirror_usb_service() envia, sem nunca esperar,
+// apenas o que cabe na FIFO (tud_cdc_write_available()): primeiro o restante da
+// linha em andamento, depois o texto da fila. Uma linha nova só começa com a fila
+// de texto vazia, então texto e linhas nunca se misturam. O envio em si usa
+// stdio_usb.out_chars(), que faz o travamento com a tarefa USB do SDK e não espera
+// quando recebe no máximo o espaço livre na FIFO.
+//
+// Texto que não cabe na fila enquanto uma linha é enviada é descartado (contado em
+// mirror_usb_text_dropped). A entrada (comandos CFG) continua pelo stdio_usb.
+//
+// Sem computador conectado, a linha em andamento (ou entregue) é descartada e
+// mirror_usb_take_lost() passa a retornar true: quem codifica as linhas deve
+// pedir um quadro chave, pois o visualizador não recebeu a linha descartada.
+
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "pico/stdio/driver.h"
+#include "hardware/sync.h"
+#include "tusb.h"
+
+// Fila de texto: comporta as mensagens geradas durante o envio de uma linha
+#define MIRROR_USB_TEXT_QUEUE 1024
+
+static char mirror_usb_text[MIRROR_USB_TEXT_QUEUE];
+static volatile uint32_t mirror_usb_text_head;  // posição do byte mais antigo
+static volatile uint32_t mirror_usb_text_count;
+static uint32_t mirror_usb_text_dropped;
+
+static const char *mirror_usb_line; // linha "@FB" em envio (NULL se nenhuma)
+static size_t mirror_usb_line_len;
+static size_t mirror_usb_line_sent;
+static bool mirror_usb_lost; // linha descartada desde a última consulta
+
+// Saída do stdio: apenas copia para a fila. Pode ser chamada de interrupções
+static void mirror_usb_out_chars(const char *buf, int len) {
+  uint32_t irq = save_and_disable_interrupts();
+
+  // Trechos que não cabem inteiros são descartados, para não truncar mensagens
+  if (mirror_usb_text_count + (uint32_t)len > MIRROR_USB_TEXT_QUEUE) {
+    mirror_usb_text_dropped += (uint32_t)len;
+  } else {
+    for (int i = 0; i < len; ++i)
+      mirror_usb_text[(mirror_usb_text_head + mirror_usb_text_count++) % MIRROR_USB_TEXT_QUEUE] = buf[i];
+  }
+
+  restore_interrupts(irq);
+}
+
+static int mirror_usb_in_chars(char *buf, int len) {
+  return stdio_usb.in_chars(buf, len);
+}
+
+static stdio_driver_t mirror_usb_driver = {
+  .out_chars = mirror_usb_out_chars,
+  .in_chars = mirror_usb_in_chars,
+#if PICO_STDIO_ENABLE_CRLF_SUPPORT
+  .crlf_enabled = PICO_STDIO_DEFAULT_CRLF,
+#endif
+};
+
+/**
+ * Substitui o stdio_usb pelo driver com fila. Chamada após stdio_init_all().
+ */
+static void mirror_usb_init(void) {
+  stdio_set_driver_enabled(&stdio_usb, false);
+  stdio_set_driver_enabled(&mirror_usb_driver, true);
+}
+
+// Envia até len bytes, limitado ao espaço livre na FIFO. Retorna a quantidade enviada
+static size_t mirror_usb_write(const char *buf, size_t len) {
+  size_t room = tud_cdc_write_available();
+
+  if (len > room)
+    len = room;
+  if (len > 0)
+    stdio_usb.out_chars(buf, (int)len);
+  return len;
+}
+
+/**
+ * Continua o envio sem esperar. Chamada pelo laço principal, nunca por interrupções.
+ */
+static void mirror_usb_service(void) {
+  // Sem computador conectado, a saída é descartada (como no stdio_usb)
+  if (!stdio_usb_connected()) {
+    uint32_t irq = save_and_disable_interrupts();
+    mirror_usb_text_count = 0;
+    restore_interrupts(irq);
+    if (mirror_usb_line != NULL) {
+      mirror_usb_line = NULL;
+      mirror_usb_lost = true;
+    }
+    return;
+  }
+
+  if (mirror_usb_line != NULL) {
+    mirror_usb_line_sent += mirror_usb_write(mirror_usb_line + mirror_usb_line_sent,
+                                             mirror_usb_line_len - mirror_usb_line_sent);
+    if (mirror_usb_line_sent < mirror_usb_line_len)
+      return;
+    mirror_usb_line = NULL;
+  }
+
+  // Texto da fila, em até dois trechos contíguos
+  while (mirror_usb_text_count > 0) {
+    uint32_t head = mirror_usb_text_head;
+    uint32_t count = mirror_usb_text_count;
+    uint32_t chunk = MIRROR_USB_TEXT_QUEUE - head < count ? MIRROR_USB_TEXT_QUEUE - head : count;
+    size_t sent = mirror_usb_write(mirror_usb_text + head, chunk);
+
+    if (sent == 0)
+      return;
+
+    uint32_t irq = save_and_disable_interrupts();
+    mirror_usb_text_head = (head + (uint32_t)sent) % MIRROR_USB_TEXT_QUEUE;
+    mirror_usb_text_count -= (uint32_t)sent;
+    restore_interrupts(irq);
+  }
+}
+
+/**
+ * Indica se uma nova linha pode ser entregue a mirror_usb_send(): nenhuma linha
+ * em andamento e nenhum texto pela metade na fila.
+ */
+static inline bool mirror_usb_idle(void) {
+  return mirror_usb_line == NULL && mirror_usb_text_count == 0;
+}
+
+/**
+ * Inicia o envio de uma linha. line deve permanecer válida até mirror_usb_idle().
+ */
+static void mirror_usb_send(const char *line, size_t len) {
+  if (!stdio_usb_connected()) {
+    mirror_usb_lost = true;
+    return;
+  }
+
+  mirror_usb_line = line;
+  mirror_usb_line_len = len;
+  mirror_usb_line_sent = 0;
+  mirror_usb_service();
+}
+
+/**
+ * Indica se alguma linha foi descartada desde a última chamada.
+ */
+static inline bool mirror_usb_take_lost(void) {
+  bool lost = mirror_usb_lost;
+  mirror_usb_lost = false;
+  return lost;
+}
+
+#endif
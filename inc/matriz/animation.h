@@ -0,0 +1,158 @@
+#ifndef __ANIMATION_INC
+#define __ANIMATION_INC
+
+// Animações da matriz de LEDs 5x5.
+//
+// Os quadros são gerados em tempo de compilação (inc/matriz/frames.h) como tabelas
+// constantes na flash, já no formato de palavras GRB enviadas à máquina PIO.
+// A reprodução é cadenciada por um alarme de hardware (timer do SDK) e cada
+// quadro é transferido por DMA direto da flash para a FIFO da máquina PIO,
+// sem uso da CPU entre os quadros.
+
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "inc/matriz/neopixel.h"
+#include "inc/matriz/frames.h"
+
+// Reprodutor de animações de uma cadeia de LEDs
+typedef struct {
+  np_strip_t *strip;
+  uint dma_channel;
+  repeating_timer_t timer;
+  bool timer_running;
+  const np_animation_t *current;
+  volatile uint16_t frame;
+  const uint32_t *volatile sent; // último quadro enviado aos LEDs
+  volatile uint64_t ready_us;    // instante a partir do qual um novo quadro pode ser enviado
+} np_player_t;
+
+// Envia um quadro por DMA. Recusa (retorna false) enquanto o quadro anterior está
+// sendo transmitido ou antes da pausa de NP_LATCH_US: palavras enviadas antes
+// disso seriam emendadas ao quadro anterior e nunca exibidas.
+static bool npPlayerSend(np_player_t *p, const uint32_t *frame) {
+  if (dma_channel_is_busy(p->dma_channel) || !pio_sm_is_tx_fifo_empty(p->strip->pio, p->strip->sm))
+    return false;
+
+  // A FIFO vazia ainda não garante o fim do último LED: vale o tempo desde o envio
+  uint64_t now = time_us_64();
+  if (now < p->ready_us)
+    return false;
+
+  dma_channel_transfer_from_buffer_now(p->dma_channel, frame, NP_MATRIX_LEDS);
+  p->ready_us = now + NP_MATRIX_LEDS * NP_LED_US + NP_LATCH_US;
+  p->sent = frame;
+  return true;
+}
+
+// Tratador do alarme de hardware: envia o quadro atual e avança
+static bool npPlayerTick(repeating_timer_t *t) {
+  np_player_t *p = (np_player_t *)t->user_data;
+  const np_animation_t *a = p->current;
+
+  if (npPlayerSend(p, a->frames[p->frame])) {
+    if (++p->frame >= a->frame_count) {
+      p->frame = 0;
+      if (!a->loop) {
+        p->timer_running = false;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static void npPlayerStop(np_player_t *p) {
+  if (p->timer_running) {
+    cancel_repeating_timer(&p->timer);
+    p->timer_running = false;
+  }
+}
+
+/**
+ * Inicializa o reprodutor para uma cadeia já inicializada com npInit.
+ * A cadeia deve ter NP_MATRIX_LEDS LEDs. Retorna false se não houver canal de DMA livre.
+ */
+bool npPlayerInit(np_player_t *p, np_strip_t *strip) {
+  int channel = dma_claim_unused_channel(false);
+  if (channel < 0 || strip->led_count != NP_MATRIX_LEDS)
+    return false;
+
+  p->strip = strip;
+  p->dma_channel = (uint)channel;
+  p->timer_running = false;
+  p->current = NULL;
+  p->frame = 0;
+  p->sent = NULL;
+  p->ready_us = 0;
+
+  // Palavras de 32 bits da flash para a FIFO TX da máquina PIO, no ritmo da própria máquina
+  dma_channel_config c = dma_channel_get_default_config(p->dma_channel);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, pio_get_dreq(strip->pio, strip->sm, true));
+  dma_channel_configure(p->dma_channel, &c, &strip->pio->txf[strip->sm], NULL, NP_MATRIX_LEDS, false);
+  return true;
+}
+
+/**
+ * Reproduz uma animação. Animações temporizadas são reiniciadas apenas se forem
+ * diferentes da atual; nas proporcionais, amount (0 a 255) escolhe o quadro.
+ */
+void npPlayerPlay(np_player_t *p, const np_animation_t *a, uint8_t amount) {
+  if (a->proportional || a->frame_count == 1) {
+    uint16_t frame = np_animation_frame(a, amount);
+    // Ignorado apenas se este quadro já foi enviado e nenhuma animação o substituiu
+    if (p->current == a && !p->timer_running && p->sent == a->frames[frame])
+      return;
+
+    npPlayerStop(p);
+    p->current = a;
+    p->frame = frame;
+    // Aguarda o fim do quadro anterior e a pausa de latch (no máximo ~1 ms)
+    while (!npPlayerSend(p, a->frames[frame]))
+      tight_loop_contents();
+    return;
+  }
+
+  if (p->current == a && p->timer_running)
+    return;
+
+  npPlayerStop(p);
+  p->current = a;
+  p->frame = 0;
+  // Período negativo: intervalo contado entre inícios, sem acumular atraso
+  p->timer_running = add_repeating_timer_us(-(int64_t)a->frame_us, npPlayerTick, p, &p->timer);
+}
+
+/**
+ * Interrompe a reprodução e aguarda o fim do quadro em transmissão, para que o DMA
+ * não leia a flash enquanto ela é gravada. Retorna true se uma animação temporizada
+ * estava em andamento (a ser informado a npPlayerResume).
+ */
+bool npPlayerPause(np_player_t *p) {
+  bool was_running = p->timer_running;
+
+  npPlayerStop(p);
+  dma_channel_wait_for_finish_blocking(p->dma_channel);
+  return was_running;
+}
+
+/**
+ * Retoma, a partir do quadro em que parou, a animação interrompida por npPlayerPause.
+ */
+void npPlayerResume(np_player_t *p, bool was_running) {
+  if (was_running && !p->timer_running && p->current != NULL)
+    p->timer_running = add_repeating_timer_us(-(int64_t)p->current->frame_us, npPlayerTick, p, &p->timer);
+}
+
+/**
+ * Seleciona a animação do nível de alarme (0 a NP_ALARM_LEVELS - 1).
+ */
+void npPlayerAlarm(np_player_t *p, uint alarm_level, uint8_t amount) {
+  if (alarm_level >= NP_ALARM_LEVELS)
+    alarm_level = NP_ALARM_LEVELS - 1;
+  npPlayerPlay(p, np_alarm_animations[alarm_level], amount);
+}
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef __FRAMES_INC
+#define __FRAMES_INC
+
+// Quadros das animações da matriz de LEDs 5x5, gerados em tempo de compilação.
+// Não depende do SDK do Pico: as tabelas também são verificadas no computador
+// (tools/tests). A reprodução fica em inc/matriz/animation.h.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Palavra enviada à máquina PIO para um LED: G nos bits 0-7, R nos bits 8-15 e B nos
+// bits 16-23 (a máquina desloca para a direita e consome 24 bits por palavra).
+#define NP_GRB(r, g, b) ((uint32_t)(g) | ((uint32_t)(r) << 8) | ((uint32_t)(b) << 16))
+
+#define NP_MATRIX_LEDS 25
+
+// Linha (0 = superior) e coluna (0 = esquerda) de cada LED na matriz da BitDogLab,
+// ligada em zigue-zague a partir do canto inferior direito (LED 0)
+#define NP_ROW(i) ((24 - (i)) / 5)
+#define NP_COL(i) ((NP_ROW(i) % 2 == 0) ? (24 - (i)) % 5 : 4 - (24 - (i)) % 5)
+
+// Gera um quadro aplicando F(i, arg) a cada um dos 25 LEDs
+#define NP_FRAME(F, a) { \
+  F(0, a),  F(1, a),  F(2, a),  F(3, a),  F(4, a),  \
+  F(5, a),  F(6, a),  F(7, a),  F(8, a),  F(9, a),  \
+  F(10, a), F(11, a), F(12, a), F(13, a), F(14, a), \
+  F(15, a), F(16, a), F(17, a), F(18, a), F(19, a), \
+  F(20, a), F(21, a), F(22, a), F(23, a), F(24, a)  \
+}
+
+// Cor do alarme (mesmo vermelho usado anteriormente) e cor de fundo das animações
+#define NP_ALARM_RED(level) NP_GRB(level, 0, 0)
+#define NP_ALARM_COLOR NP_ALARM_RED(80)
+#define NP_DIM_COLOR NP_ALARM_RED(8)
+
+// Funções de pixel: todos com a cor a / coluna a acesa / primeiros a LEDs (de baixo para cima)
+#define NP_PX_FILL(i, a) (a)
+#define NP_PX_SWEEP(i, a) (NP_COL(i) == (a) ? NP_ALARM_COLOR : NP_DIM_COLOR)
+#define NP_PX_LEVEL(i, a) ((4 - NP_ROW(i)) * 5 + NP_COL(i) < (a) ? NP_ALARM_COLOR : 0)
+
+typedef struct {
+  const uint32_t (*frames)[NP_MATRIX_LEDS];
+  uint16_t frame_count;
+  uint32_t frame_us;  // duração de cada quadro
+  bool loop;
+  bool proportional;  // o quadro é escolhido pelo nível, não pelo tempo
+} np_animation_t;
+
+// Apagado
+static const uint32_t np_frames_off[][NP_MATRIX_LEDS] = {
+  NP_FRAME(NP_PX_FILL, 0),
+};
+
+// Pulsação: brilho sobe e desce
+static const uint32_t np_frames_pulse[][NP_MATRIX_LEDS] = {
+  NP_FRAME(NP_PX_FILL, NP_ALARM_RED(8)),
+  NP_FRAME(NP_PX_FILL, NP_ALARM_RED(16)),
+  NP_FRAME(NP_PX_FILL, NP_ALARM_RED(32)),
+  NP_FRAME(NP_PX_FILL, NP_ALARM_RED(48)),
+  NP_FRAME(NP_PX_FILL, NP_ALARM_RED(64)),
+  NP_FRAME(NP_PX_FILL, NP_ALARM_RED(80)),
+  NP_FRAME(NP_PX_FILL, NP_ALARM_RED(64)),
+  NP_FRAME(NP_PX_FILL, NP_ALARM_RED(48)),
+  NP_FRAME(NP_PX_FILL, NP_ALARM_RED(32)),
+  NP_FRAME(NP_PX_FILL, NP_ALARM_RED(16)),
+};
+
+// Varredura: uma coluna acesa percorre a matriz e volta
+static const uint32_t np_frames_sweep[][NP_MATRIX_LEDS] = {
+  NP_FRAME(NP_PX_SWEEP, 0),
+  NP_FRAME(NP_PX_SWEEP, 1),
+  NP_FRAME(NP_PX_SWEEP, 2),
+  NP_FRAME(NP_PX_SWEEP, 3),
+  NP_FRAME(NP_PX_SWEEP, 4),
+  NP_FRAME(NP_PX_SWEEP, 3),
+  NP_FRAME(NP_PX_SWEEP, 2),
+  NP_FRAME(NP_PX_SWEEP, 1),
+};
+
+// Preenchimento proporcional: o quadro k tem k LEDs acesos
+static const uint32_t np_frames_level[][NP_MATRIX_LEDS] = {
+  NP_FRAME(NP_PX_LEVEL, 0),  NP_FRAME(NP_PX_LEVEL, 1),  NP_FRAME(NP_PX_LEVEL, 2),
+  NP_FRAME(NP_PX_LEVEL, 3),  NP_FRAME(NP_PX_LEVEL, 4),  NP_FRAME(NP_PX_LEVEL, 5),
+  NP_FRAME(NP_PX_LEVEL, 6),  NP_FRAME(NP_PX_LEVEL, 7),  NP_FRAME(NP_PX_LEVEL, 8),
+  NP_FRAME(NP_PX_LEVEL, 9),  NP_FRAME(NP_PX_LEVEL, 10), NP_FRAME(NP_PX_LEVEL, 11),
+  NP_FRAME(NP_PX_LEVEL, 12), NP_FRAME(NP_PX_LEVEL, 13), NP_FRAME(NP_PX_LEVEL, 14),
+  NP_FRAME(NP_PX_LEVEL, 15), NP_FRAME(NP_PX_LEVEL, 16), NP_FRAME(NP_PX_LEVEL, 17),
+  NP_FRAME(NP_PX_LEVEL, 18), NP_FRAME(NP_PX_LEVEL, 19), NP_FRAME(NP_PX_LEVEL, 20),
+  NP_FRAME(NP_PX_LEVEL, 21), NP_FRAME(NP_PX_LEVEL, 22), NP_FRAME(NP_PX_LEVEL, 23),
+  NP_FRAME(NP_PX_LEVEL, 24), NP_FRAME(NP_PX_LEVEL, 25),
+};
+
+#define NP_FRAME_COUNT(t) ((uint16_t)(sizeof(t) / sizeof((t)[0])))
+
+// Verificações das tabelas geradas
+_Static_assert(sizeof(np_frames_pulse[0]) == NP_MATRIX_LEDS * sizeof(uint32_t), "quadro deve ter 25 LEDs");
+_Static_assert(NP_FRAME_COUNT(np_frames_level) == NP_MATRIX_LEDS + 1, "um quadro por quantidade de LEDs acesos");
+_Static_assert(NP_COL(0) == 4 && NP_COL(4) == 0 && NP_COL(5) == 0 && NP_ROW(0) == 4 && NP_ROW(24) == 0, "mapeamento da matriz");
+
+static const np_animation_t np_anim_off = { np_frames_off, NP_FRAME_COUNT(np_frames_off), 0, false, false };
+static const np_animation_t np_anim_pulse = { np_frames_pulse, NP_FRAME_COUNT(np_frames_pulse), 60000, true, false };
+static const np_animation_t np_anim_sweep = { np_frames_sweep, NP_FRAME_COUNT(np_frames_sweep), 80000, true, false };
+static const np_animation_t np_anim_level = { np_frames_level, NP_FRAME_COUNT(np_frames_level), 0, false, true };
+
+// Níveis de alarme (ver level_alarm_level em inc/audio/level.h)
+#define NP_ALARM_LEVELS 3
+
+// Animação de cada nível de alarme: desligado, acima do limite, muito acima do limite
+static const np_animation_t *const np_alarm_animations[NP_ALARM_LEVELS] = {
+  &np_anim_off, &np_anim_level, &np_anim_pulse
+};
+
+// Quadro de uma animação proporcional para amount de 0 (primeiro) a 255 (último)
+static inline uint16_t np_animation_frame(const np_animation_t *a, uint8_t amount) {
+  return (uint16_t)((amount * (a->frame_count - 1) + 127) / 255);
+}
+
+#endif
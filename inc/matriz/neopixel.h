@@ -3,6 +3,12 @@
 
 #include <stdlib.h>
 #include "ws2818b.pio.h"
+#include "inc/matriz/frames.h" // NP_GRB
+
+// Duração da transmissão de um LED (24 bits a 800 kHz) e pausa, com a linha em
+// nível baixo, que faz os LEDs exibirem o quadro recebido (mínimo de 280 us)
+#define NP_LED_US 30
+#define NP_LATCH_US 300
 
 // Definição de pixel GRB
 struct pixel_t {
@@ -11,73 +17,99 @@ struct pixel_t {
 typedef struct pixel_t pixel_t;
 typedef pixel_t npLED_t; // Mudança de nome de "struct pixel_t" para "npLED_t" por clareza.
 
+// Instância de uma cadeia de LEDs: buffer de pixels e máquina PIO que a controla.
+typedef struct {
+  npLED_t *leds;
+  uint led_count;
+  PIO pio;
+  uint sm;
+} np_strip_t;
 
-// Declaração do buffer de pixels que formam a matriz.
-static npLED_t *leds;
-static uint led_count;
+// Declara uma cadeia de LEDs com o buffer alocado estaticamente.
+// Ex.: NP_STRIP_DEFINE(matrix, 25);
+#define NP_STRIP_DEFINE(name, count)        \
+  static npLED_t name##_leds[count];        \
+  np_strip_t name = { .leds = name##_leds, .led_count = (count) }
 
-// Variáveis para uso da máquina PIO.
-static PIO np_pio;
-static uint np_sm;
+// O programa PIO é carregado uma única vez por bloco PIO e compartilhado entre as cadeias.
+static bool np_program_loaded[NUM_PIOS];
+static uint np_program_offset[NUM_PIOS];
 
 /**
- * Inicializa a máquina PIO para controle da matriz de LEDs.
+ * Tenta obter uma máquina de estados livre no bloco PIO informado.
  */
-void npInit(uint pin, uint amount) {
-
-  led_count = amount;
-  leds = (npLED_t *)calloc(led_count, sizeof(npLED_t));
-
-  // Cria programa PIO.
-  uint offset = pio_add_program(pio0, &ws2818b_program);
-  np_pio = pio0;
+static bool npClaim(np_strip_t *np, PIO pio) {
+  uint index = pio_get_index(pio);
 
-  // Toma posse de uma máquina PIO.
-  np_sm = pio_claim_unused_sm(np_pio, false);
-  if (np_sm < 0) {
-    np_pio = pio1;
-    np_sm = pio_claim_unused_sm(np_pio, true); // Se nenhuma máquina estiver livre, panic!
+  // Carrega o programa PIO caso ainda não esteja presente neste bloco.
+  if (!np_program_loaded[index]) {
+    if (!pio_can_add_program(pio, &ws2818b_program))
+      return false;
+    np_program_offset[index] = pio_add_program(pio, &ws2818b_program);
+    np_program_loaded[index] = true;
   }
 
-  // Inicia programa na máquina PIO obtida.
-  ws2818b_program_init(np_pio, np_sm, offset, pin, 800000.f);
+  // Toma posse de uma máquina PIO.
+  int sm = pio_claim_unused_sm(pio, false);
+  if (sm < 0)
+    return false;
 
-  // Limpa buffer de pixels.
-  for (uint i = 0; i < led_count; ++i) {
-    leds[i].R = 0;
-    leds[i].G = 0;
-    leds[i].B = 0;
-  }
+  np->pio = pio;
+  np->sm = (uint)sm;
+  return true;
 }
 
 /**
  * Atribui uma cor RGB a um LED.
  */
-void npSetLED(const uint index, const uint8_t r, const uint8_t g, const uint8_t b) {
-  leds[index].R = r;
-  leds[index].G = g;
-  leds[index].B = b;
+void npSetLED(np_strip_t *np, const uint index, const uint8_t r, const uint8_t g, const uint8_t b) {
+  np->leds[index].R = r;
+  np->leds[index].G = g;
+  np->leds[index].B = b;
 }
 
 /**
  * Limpa o buffer de pixels.
  */
-void npClear() {
-  for (uint i = 0; i < led_count; ++i)
-    npSetLED(i, 0, 0, 0);
+void npClear(np_strip_t *np) {
+  for (uint i = 0; i < np->led_count; ++i)
+    npSetLED(np, i, 0, 0, 0);
+}
+
+/**
+ * Inicializa a máquina PIO para controle da cadeia de LEDs.
+ * A cadeia deve ter sido declarada com NP_STRIP_DEFINE.
+ * Retorna false se não houver máquina PIO livre.
+ */
+bool npInit(np_strip_t *np, uint pin) {
+  if (np->leds == NULL)
+    return false;
+
+  // Procura uma máquina livre no pio0 e, se não houver, no pio1.
+  if (!npClaim(np, pio0) && !npClaim(np, pio1))
+    return false;
+
+  // Inicia programa na máquina PIO obtida.
+  ws2818b_program_init(np->pio, np->sm, np_program_offset[pio_get_index(np->pio)], pin, 800000.f);
+
+  // Limpa buffer de pixels.
+  npClear(np);
+  return true;
 }
 
 /**
  * Escreve os dados do buffer nos LEDs.
  */
-void npWrite() {
-  // Escreve cada dado de 8-bits dos pixels em sequência no buffer da máquina PIO.
-  for (uint i = 0; i < led_count; ++i) {
-    pio_sm_put_blocking(np_pio, np_sm, leds[i].G);
-    pio_sm_put_blocking(np_pio, np_sm, leds[i].R);
-    pio_sm_put_blocking(np_pio, np_sm, leds[i].B);
-  }
-  sleep_us(100); // Espera 100us, sinal de RESET do datasheet.
+void npWrite(np_strip_t *np) {
+  // Escreve uma palavra GRB por LED em sequência no buffer da máquina PIO.
+  for (uint i = 0; i < np->led_count; ++i)
+    pio_sm_put_blocking(np->pio, np->sm, NP_GRB(np->leds[i].R, np->leds[i].G, np->leds[i].B));
+
+  // Aguarda a FIFO esvaziar e o último LED ser transmitido, e então a pausa de
+  // latch (RESET do datasheet) antes de qualquer nova escrita
+  while (!pio_sm_is_tx_fifo_empty(np->pio, np->sm))
+    tight_loop_contents();
+  sleep_us(NP_LED_US + NP_LATCH_US);
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,135 @@
+#include <string.h>
+#include "inc/net/telemetry.h"
+
+static void put16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static void put32(uint8_t *p, uint32_t v) {
+  put16(p, (uint16_t)v);
+  put16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint16_t get16(const uint8_t *p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t *p) {
+  return get16(p) | ((uint32_t)get16(p + 2) << 16);
+}
+
+void telemetry_init(telemetry_t *t, uint32_t interval_ms, uint32_t now_ms) {
+  memset(t, 0, sizeof(*t));
+  t->interval_ms = interval_ms;
+  t->last_send_ms = now_ms;
+}
+
+void telemetry_push(telemetry_t *t, const telemetry_record_t *r) {
+  if (t->count == TELEMETRY_QUEUE_LEN) {
+    t->head = (t->head + 1) % TELEMETRY_QUEUE_LEN;
+    t->count--;
+    t->dropped++;
+  }
+
+  t->queue[(t->head + t->count) % TELEMETRY_QUEUE_LEN] = *r;
+  t->count++;
+  t->next_seq++;
+}
+
+bool telemetry_due(const telemetry_t *t, uint32_t now_ms) {
+  if (t->count == 0)
+    return false;
+  return t->count >= TELEMETRY_MAX_BATCH || now_ms - t->last_send_ms >= t->interval_ms;
+}
+
+size_t telemetry_encode(telemetry_t *t, uint8_t *buf, size_t len, uint32_t now_ms) {
+  uint32_t n = t->count < TELEMETRY_MAX_BATCH ? t->count : TELEMETRY_MAX_BATCH;
+
+  if (n == 0 || len < TELEMETRY_HEADER_SIZE + n * TELEMETRY_RECORD_SIZE)
+    return 0;
+
+  buf[0] = TELEMETRY_MAGIC0;
+  buf[1] = TELEMETRY_MAGIC1;
+  buf[2] = TELEMETRY_VERSION;
+  buf[3] = (uint8_t)n;
+  put32(buf + 4, t->next_seq - t->count); // sequência do registro mais antigo na fila
+  put32(buf + 8, t->dropped);
+  put32(buf + 12, 0);
+
+  uint8_t *p = buf + TELEMETRY_HEADER_SIZE;
+  for (uint32_t i = 0; i < n; ++i, p += TELEMETRY_RECORD_SIZE) {
+    const telemetry_record_t *r = &t->queue[(t->head + i) % TELEMETRY_QUEUE_LEN];
+    put32(p, r->t_ms);
+    put16(p + 4, r->peak_to_peak);
+    p[6] = r->db;
+    p[7] = r->flags;
+    p[8] = r->alarm;
+  }
+
+  t->head = (t->head + n) % TELEMETRY_QUEUE_LEN;
+  t->count -= n;
+  t->last_send_ms = now_ms;
+  t->datagrams++;
+  return TELEMETRY_HEADER_SIZE + n * TELEMETRY_RECORD_SIZE;
+}
+
+int telemetry_decode(const uint8_t *buf, size_t len, telemetry_header_t *h, telemetry_record_t *records, size_t max) {
+  if (len < TELEMETRY_HEADER_SIZE || buf[0] != TELEMETRY_MAGIC0 || buf[1] != TELEMETRY_MAGIC1)
+    return -1;
+
+  h->version = buf[2];
+  h->count = buf[3];
+  h->first_seq = get32(buf + 4);
+  h->dropped = get32(buf + 8);
+
+  if (h->version != TELEMETRY_VERSION || len != TELEMETRY_HEADER_SIZE + (size_t)h->count * TELEMETRY_RECORD_SIZE)
+    return -1;
+
+  size_t n = h->count < max ? h->count : max;
+  const uint8_t *p = buf + TELEMETRY_HEADER_SIZE;
+  for (size_t i = 0; i < n; ++i, p += TELEMETRY_RECORD_SIZE) {
+    records[i].t_ms = get32(p);
+    records[i].peak_to_peak = get16(p + 4);
+    records[i].db = p[6];
+    records[i].flags = p[7];
+    records[i].alarm = p[8];
+  }
+  return (int)n;
+}
+
+void telemetry_rx_init(telemetry_rx_t *rx) {
+  memset(rx, 0, sizeof(*rx));
+}
+
+int telemetry_rx_receive(telemetry_rx_t *rx, const uint8_t *buf, size_t len, telemetry_header_t *h,
+                         telemetry_record_t *records, size_t max) {
+  int n = telemetry_decode(buf, len, h, records, max);
+  if (n < 0) {
+    rx->stats.invalid++;
+    return -1;
+  }
+
+  rx->stats.datagrams++;
+  if (rx->have_seq && (int32_t)(h->first_seq - rx->next_seq) < 0) {
+    // Duplicado ou atrasado: os registros já foram contados como perdidos
+    rx->stats.out_of_order++;
+    return 0;
+  }
+
+  if (rx->have_seq) {
+    // Lacuna na sequência: parte foi descartada pela fila do emissor, o resto se perdeu na rede
+    uint32_t gap = h->first_seq - rx->next_seq;
+    uint32_t dropped = h->dropped - rx->last_dropped;
+    if (dropped > gap)
+      dropped = gap;
+    rx->stats.dropped += dropped;
+    rx->stats.lost += gap - dropped;
+  }
+
+  rx->have_seq = true;
+  rx->next_seq = h->first_seq + h->count;
+  rx->last_dropped = h->dropped;
+  rx->stats.records += h->count;
+  return n;
+}
@@ -0,0 +1,99 @@
+#ifndef __TELEMETRY_INC
+#define __TELEMETRY_INC
+
+// Telemetria dos níveis medidos em datagramas UDP compactos.
+//
+// Cada medição vira um registro numerado na fila. A fila tem tamanho fixo e,
+// cheia, descarta o registro mais antigo: uma rede lenta ou fora do ar nunca
+// segura a medição. A cada interval_ms (ou quando há registros suficientes
+// para um datagrama cheio) os registros pendentes são codificados em um
+// datagrama. Não depende do SDK do Pico nem do lwIP: o envio fica com quem chama.
+//
+// Formato (little-endian):
+//   cabeçalho: magic "DT" (2), versão (1), quantidade (1), sequência do primeiro
+//              registro (4), total descartado pela fila (4), reservado (4)
+//   registro:  instante em ms (4), pico a pico (2), dB (1), indicadores LEVEL_FLAG_* (1),
+//              nível do alarme (1)
+// Lacunas na sequência que não foram descartadas pela fila foram perdidas na rede.
+// A contagem do lado do receptor (telemetry_rx_t) é usada por tools/telemetry.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TELEMETRY_MAGIC0 'D'
+#define TELEMETRY_MAGIC1 'T'
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_HEADER_SIZE 16
+#define TELEMETRY_RECORD_SIZE 9
+
+// Registros por datagrama e capacidade da fila
+#define TELEMETRY_MAX_BATCH 64
+#define TELEMETRY_QUEUE_LEN 256
+#define TELEMETRY_MAX_DATAGRAM (TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_BATCH * TELEMETRY_RECORD_SIZE)
+
+typedef struct {
+  uint32_t t_ms;
+  uint16_t peak_to_peak;
+  uint8_t db;
+  uint8_t flags;
+  uint8_t alarm;
+} telemetry_record_t;
+
+typedef struct {
+  telemetry_record_t queue[TELEMETRY_QUEUE_LEN];
+  uint32_t head;     // posição do registro mais antigo
+  uint32_t count;
+  uint32_t next_seq; // sequência do próximo registro colocado na fila
+  uint32_t dropped;  // registros descartados por falta de espaço
+  uint32_t interval_ms;
+  uint32_t last_send_ms;
+  uint32_t datagrams;
+} telemetry_t;
+
+// Cabeçalho decodificado
+typedef struct {
+  uint8_t version;
+  uint8_t count;
+  uint32_t first_seq;
+  uint32_t dropped;
+} telemetry_header_t;
+
+void telemetry_init(telemetry_t *t, uint32_t interval_ms, uint32_t now_ms);
+
+// Coloca um registro na fila, descartando o mais antigo se estiver cheia
+void telemetry_push(telemetry_t *t, const telemetry_record_t *r);
+
+// Indica se um datagrama deve ser enviado agora
+bool telemetry_due(const telemetry_t *t, uint32_t now_ms);
+
+// Retira até TELEMETRY_MAX_BATCH registros da fila e os codifica em buf.
+// Retorna o tamanho do datagrama (0 se a fila está vazia ou buf é pequeno).
+size_t telemetry_encode(telemetry_t *t, uint8_t *buf, size_t len, uint32_t now_ms);
+
+// Decodifica um datagrama. Retorna a quantidade de registros (até max) ou -1 se inválido.
+int telemetry_decode(const uint8_t *buf, size_t len, telemetry_header_t *h, telemetry_record_t *records, size_t max);
+
+// Totais do receptor
+typedef struct {
+  uint64_t datagrams, records, dropped, lost, out_of_order, invalid;
+} telemetry_rx_stats_t;
+
+// Receptor: confere a sequência dos datagramas recebidos
+typedef struct {
+  telemetry_rx_stats_t stats;
+  bool have_seq;
+  uint32_t next_seq;     // sequência esperada no próximo datagrama
+  uint32_t last_dropped; // total descartado pelo emissor no último datagrama
+} telemetry_rx_t;
+
+void telemetry_rx_init(telemetry_rx_t *rx);
+
+// Decodifica e contabiliza um datagrama recebido. Lacunas na sequência são contadas
+// como descartadas pelo emissor (até o aumento do seu total) ou perdidas na rede.
+// Retorna a quantidade de registros novos em records (0 para um datagrama duplicado
+// ou atrasado) ou -1 se inválido.
+int telemetry_rx_receive(telemetry_rx_t *rx, const uint8_t *buf, size_t len, telemetry_header_t *h,
+                         telemetry_record_t *records, size_t max);
+
+#endif
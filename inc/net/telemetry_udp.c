@@ -0,0 +1,79 @@
+#include <string.h>
+#include "pico/cyw43_arch.h"
+#include "lwip/ip_addr.h"
+#include "lwip/pbuf.h"
+#include "lwip/udp.h"
+#include "inc/net/telemetry_udp.h"
+
+static struct udp_pcb *telemetry_pcb;
+static ip_addr_t telemetry_addr;
+static uint16_t telemetry_port;
+static const char *telemetry_ssid;
+static const char *telemetry_password;
+static uint32_t telemetry_last_attempt_ms;
+
+static uint8_t telemetry_datagram[TELEMETRY_MAX_DATAGRAM];
+
+static bool telemetry_udp_connect(uint32_t now_ms) {
+  telemetry_last_attempt_ms = now_ms;
+  return cyw43_arch_wifi_connect_async(telemetry_ssid, telemetry_password, CYW43_AUTH_WPA2_AES_PSK) == 0;
+}
+
+bool telemetry_udp_init(const char *ssid, const char *password, const char *host, uint16_t port, uint32_t now_ms) {
+  if (!ipaddr_aton(host, &telemetry_addr))
+    return false;
+  if (cyw43_arch_init() != 0)
+    return false;
+
+  cyw43_arch_enable_sta_mode();
+  telemetry_ssid = ssid;
+  telemetry_password = password;
+  telemetry_port = port;
+
+  cyw43_arch_lwip_begin();
+  telemetry_pcb = udp_new_ip_type(IPADDR_TYPE_ANY);
+  cyw43_arch_lwip_end();
+  if (telemetry_pcb == NULL)
+    return false;
+
+  // A medição começa sem esperar pela conexão
+  return telemetry_udp_connect(now_ms);
+}
+
+bool telemetry_udp_link_up(void) {
+  return cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA) == CYW43_LINK_UP;
+}
+
+void telemetry_udp_service(telemetry_t *t, uint32_t now_ms) {
+  if (telemetry_pcb == NULL)
+    return;
+
+  int status = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA);
+  if (status != CYW43_LINK_UP) {
+    // Sem conexão (falha, queda ou associação/DHCP parados em JOIN ou NOIP):
+    // nova tentativa de tempos em tempos. Uma associação em andamento é desfeita antes
+    if (now_ms - telemetry_last_attempt_ms >= TELEMETRY_UDP_RETRY_MS) {
+      if (status == CYW43_LINK_JOIN || status == CYW43_LINK_NOIP)
+        cyw43_wifi_leave(&cyw43_state, CYW43_ITF_STA);
+      telemetry_udp_connect(now_ms);
+    }
+    return;
+  }
+
+  if (!telemetry_due(t, now_ms))
+    return;
+
+  size_t len = telemetry_encode(t, telemetry_datagram, sizeof(telemetry_datagram), now_ms);
+  if (len == 0)
+    return;
+
+  // Sem memória no lwIP o datagrama é descartado; o receptor conta a lacuna como perda
+  cyw43_arch_lwip_begin();
+  struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, (u16_t)len, PBUF_RAM);
+  if (p != NULL) {
+    memcpy(p->payload, telemetry_datagram, len);
+    udp_sendto(telemetry_pcb, p, &telemetry_addr, telemetry_port);
+    pbuf_free(p);
+  }
+  cyw43_arch_lwip_end();
+}
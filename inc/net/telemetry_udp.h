@@ -0,0 +1,25 @@
+#ifndef __TELEMETRY_UDP_INC
+#define __TELEMETRY_UDP_INC
+
+// Envio da telemetria por UDP no Pico W (lwIP com cyw43_arch em segundo plano).
+// A conexão Wi-Fi é assíncrona e o envio nunca espera pela rede: sem conexão,
+// os registros continuam na fila de telemetry_t, que descarta os mais antigos.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/net/telemetry.h"
+
+// Intervalo entre tentativas de conexão ao Wi-Fi: sem conexão ativa após esse tempo,
+// inclusive com a associação ou o DHCP parados, a conexão é refeita
+#define TELEMETRY_UDP_RETRY_MS 10000
+
+// Inicia o Wi-Fi e o socket UDP. Retorna false se o Wi-Fi ou o endereço forem inválidos.
+bool telemetry_udp_init(const char *ssid, const char *password, const char *host, uint16_t port, uint32_t now_ms);
+
+// Envia um datagrama quando devido e refaz a conexão se ela cair
+void telemetry_udp_service(telemetry_t *t, uint32_t now_ms);
+
+// Indica se a conexão Wi-Fi está ativa (com endereço IP)
+bool telemetry_udp_link_up(void);
+
+#endif
@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <string.h>
+#include "inc/power/governor.h"
+
+static const char *const governor_names[GOVERNOR_STATE_COUNT] = {
+  "ativo", "estavel", "reduzido", "vigilia"
+};
+
+const governor_config_t governor_default_config = {
+  .stable_after_ms = 5000,  // 5 s sem atividade: atualiza a GUI a cada 500 ms
+  .dim_after_ms = 30000,    // 30 s: reduz o brilho do display
+  .sleep_after_ms = 120000, // 2 min: desliga o display e mede em janelas curtas
+  .stable_delta_db = 3,
+  .wake_db = 60,            // o firmware acompanha o limite definido pelo usuário
+  .refresh_ms = { 0, 500, 1000, 0 },
+  .contrast = { 0xFF, 0xFF, 0x10, 0x00 },
+  .watch_window_ms = 10,
+  .watch_interval_ms = 500,
+};
+
+void governor_init(governor_t *g, const governor_config_t *cfg, uint32_t now_ms) {
+  memset(g, 0, sizeof(*g));
+  g->cfg = *cfg;
+  g->state = GOVERNOR_ACTIVE;
+  g->last_activity_ms = now_ms;
+  g->last_update_ms = now_ms;
+  g->last_refresh_ms = now_ms;
+  g->refresh_forced = true;
+}
+
+static governor_state_t governor_state_for(const governor_t *g, uint32_t idle_ms) {
+  if (idle_ms >= g->cfg.sleep_after_ms)
+    return GOVERNOR_SLEEP;
+  if (idle_ms >= g->cfg.dim_after_ms)
+    return GOVERNOR_DIM;
+  if (idle_ms >= g->cfg.stable_after_ms)
+    return GOVERNOR_STABLE;
+  return GOVERNOR_ACTIVE;
+}
+
+governor_state_t governor_update(governor_t *g, uint32_t now_ms, unsigned int db_value) {
+  bool activity = false;
+
+  // Contabiliza o tempo no estado anterior
+  g->residency_ms[g->state] += now_ms - g->last_update_ms;
+  g->last_update_ms = now_ms;
+
+  if (g->input_pending) {
+    g->input_pending = false;
+    activity = true;
+  }
+
+  if (db_value >= g->cfg.wake_db) {
+    activity = true;
+  } else if (g->state != GOVERNOR_SLEEP) {
+    // Em vigília a janela é curta e o valor não é comparável; só o limiar acorda
+    unsigned int delta = db_value > g->ref_db ? db_value - g->ref_db : g->ref_db - db_value;
+    if (delta > g->cfg.stable_delta_db)
+      activity = true;
+  }
+
+  if (activity) {
+    g->last_activity_ms = now_ms;
+    g->ref_db = db_value;
+  }
+
+  governor_state_t next = governor_state_for(g, now_ms - g->last_activity_ms);
+  if (next != g->state) {
+    if (next == GOVERNOR_ACTIVE)
+      g->wakeups++;
+    g->state = next;
+    g->refresh_forced = true;
+  }
+
+  return g->state;
+}
+
+bool governor_refresh_due(governor_t *g, uint32_t now_ms) {
+  if (g->state == GOVERNOR_SLEEP && !g->refresh_forced)
+    return false;
+
+  if (g->refresh_forced || now_ms - g->last_refresh_ms >= g->cfg.refresh_ms[g->state]) {
+    g->refresh_forced = false;
+    g->last_refresh_ms = now_ms;
+    return true;
+  }
+
+  return false;
+}
+
+const char *governor_state_name(governor_state_t state) {
+  return state < GOVERNOR_STATE_COUNT ? governor_names[state] : "?";
+}
+
+size_t governor_format_residency(const governor_t *g, char *buf, size_t len) {
+  uint64_t total = 0;
+  size_t used = 0;
+
+  for (int i = 0; i < GOVERNOR_STATE_COUNT; ++i)
+    total += g->residency_ms[i];
+
+  for (int i = 0; i < GOVERNOR_STATE_COUNT && used < len; ++i) {
+    double pct = total ? 100.0 * (double)g->residency_ms[i] / (double)total : 0.0;
+    int n = snprintf(buf + used, len - used, "%s%s %.1f%%", i ? " " : "", governor_names[i], pct);
+    if (n < 0)
+      break;
+    used += (size_t)n;
+  }
+
+  if (used < len) {
+    int n = snprintf(buf + used, len - used, " despertares %lu", (unsigned long)g->wakeups);
+    if (n > 0)
+      used += (size_t)n;
+  }
+
+  return used < len ? used : len - 1;
+}
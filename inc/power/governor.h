@@ -0,0 +1,88 @@
+#ifndef __GOVERNOR_INC
+#define __GOVERNOR_INC
+
+// Controle adaptativo da taxa de atualização e do modo de baixo consumo.
+//
+// O estado depende do tempo desde a última atividade (botão, variação do nível
+// maior que stable_delta_db ou nível acima de wake_db):
+//   ACTIVE -> STABLE -> DIM -> SLEEP
+// Qualquer atividade volta imediatamente para ACTIVE. Não depende do SDK do Pico:
+// o tempo é sempre informado por quem chama (relógio real ou virtual).
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+  GOVERNOR_ACTIVE, // taxa máxima
+  GOVERNOR_STABLE, // valores estáveis: atualização mais lenta
+  GOVERNOR_DIM,    // sem interação: display com brilho reduzido
+  GOVERNOR_SLEEP,  // display desligado e ADC em modo de vigília
+  GOVERNOR_STATE_COUNT
+} governor_state_t;
+
+typedef struct {
+  uint32_t stable_after_ms; // inatividade para entrar em STABLE
+  uint32_t dim_after_ms;    // inatividade para entrar em DIM
+  uint32_t sleep_after_ms;  // inatividade para entrar em SLEEP
+  unsigned int stable_delta_db; // variação considerada atividade
+  unsigned int wake_db;         // nível que acorda o sistema
+  uint32_t refresh_ms[GOVERNOR_STATE_COUNT]; // intervalo entre atualizações da GUI/LEDs
+  uint8_t contrast[GOVERNOR_STATE_COUNT];    // contraste do display
+  uint32_t watch_window_ms;   // janela de medição em SLEEP
+  uint32_t watch_interval_ms; // intervalo entre medições em SLEEP
+} governor_config_t;
+
+typedef struct {
+  governor_config_t cfg;
+  governor_state_t state;
+  uint32_t last_activity_ms;
+  uint32_t last_update_ms;
+  uint32_t last_refresh_ms;
+  unsigned int ref_db;
+  bool refresh_forced;
+  volatile bool input_pending; // escrito pela interrupção dos botões
+  uint64_t residency_ms[GOVERNOR_STATE_COUNT];
+  uint32_t wakeups;
+} governor_t;
+
+// Parâmetros usados pelo firmware
+extern const governor_config_t governor_default_config;
+
+void governor_init(governor_t *g, const governor_config_t *cfg, uint32_t now_ms);
+
+// Registra uma interação do usuário. Pode ser chamada a partir de interrupções.
+static inline void governor_notify_input(governor_t *g) {
+  g->input_pending = true;
+}
+
+// Nível a informar para uma janela com o ADC saturado: a leitura em dB é inválida,
+// mas o som é o mais alto mensurável e deve contar como atividade
+#define GOVERNOR_DB_OVERLOAD UINT_MAX
+
+// Atualiza o estado com a última medição. Retorna o novo estado.
+governor_state_t governor_update(governor_t *g, uint32_t now_ms, unsigned int db_value);
+
+// Indica se a GUI e os LEDs devem ser atualizados agora
+bool governor_refresh_due(governor_t *g, uint32_t now_ms);
+
+// Janela de medição a ser usada no estado atual
+static inline uint32_t governor_sample_window_ms(const governor_t *g, uint32_t full_window_ms) {
+  return g->state == GOVERNOR_SLEEP ? g->cfg.watch_window_ms : full_window_ms;
+}
+
+static inline bool governor_display_on(const governor_t *g) {
+  return g->state != GOVERNOR_SLEEP;
+}
+
+static inline uint8_t governor_contrast(const governor_t *g) {
+  return g->cfg.contrast[g->state];
+}
+
+const char *governor_state_name(governor_state_t state);
+
+// Escreve a permanência (%) em cada estado, ex.: "ativo 12.5% estavel 80.0% ..."
+size_t governor_format_residency(const governor_t *g, char *buf, size_t len);
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef __SSD1306_CONTROLLER_SH1106_INC
+#define __SSD1306_CONTROLLER_SH1106_INC
+
+// Controlador SH1106: só possui endereçamento por página e a RAM tem 132
+// colunas, com o painel de 128 colunas começando na coluna 2.
+
+#define CONTROLLER_NAME "SH1106"
+
+#define SH1106_COLUMN_OFFSET 2
+#define SH1106_SET_PAGE 0xB0
+#define SH1106_SET_COL_LOW 0x00
+#define SH1106_SET_COL_HIGH 0x10
+#define SH1106_SET_DCDC 0xAD
+#define SH1106_SET_PUMP_VOLTAGE 0x30
+
+static inline void controller_config(ssd1306_t *ssd) {
+  transport_command(ssd, SET_DISP | 0x00);
+  transport_command(ssd, SET_DISP_CLK_DIV);
+  transport_command(ssd, 0x80);
+  transport_command(ssd, SET_MUX_RATIO);
+  transport_command(ssd, ssd->height - 1);
+  transport_command(ssd, SET_DISP_OFFSET);
+  transport_command(ssd, 0x00);
+  transport_command(ssd, SET_DISP_START_LINE | 0x00);
+  transport_command(ssd, SH1106_SET_DCDC);
+  transport_command(ssd, ssd->external_vcc ? 0x8A : 0x8B);
+  transport_command(ssd, SET_SEG_REMAP | 0x01);
+  transport_command(ssd, SET_COM_OUT_DIR | 0x08);
+  transport_command(ssd, SET_COM_PIN_CFG);
+  transport_command(ssd, 0x12);
+  transport_command(ssd, SET_CONTRAST);
+  transport_command(ssd, 0xFF);
+  transport_command(ssd, SET_PRECHARGE);
+  transport_command(ssd, 0x1F);
+  transport_command(ssd, SET_VCOM_DESEL);
+  transport_command(ssd, 0x40);
+  transport_command(ssd, SH1106_SET_PUMP_VOLTAGE | 0x02);
+  transport_command(ssd, SET_ENTIRE_ON);
+  transport_command(ssd, SET_NORM_INV);
+  transport_command(ssd, SET_DISP | 0x01);
+}
+
+static inline void controller_flush(ssd1306_t *ssd) {
+  for (uint8_t page = 0; page < ssd->pages; ++page) {
+    transport_command(ssd, SH1106_SET_PAGE | page);
+    transport_command(ssd, SH1106_SET_COL_LOW | (SH1106_COLUMN_OFFSET & 0x0F));
+    transport_command(ssd, SH1106_SET_COL_HIGH | (SH1106_COLUMN_OFFSET >> 4));
+    transport_data(ssd, ssd->ram_buffer + 1 + page * ssd->width, ssd->width);
+  }
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef __SSD1306_CONTROLLER_SSD1306_INC
+#define __SSD1306_CONTROLLER_SSD1306_INC
+
+// Controlador SSD1306: endereçamento horizontal, o framebuffer inteiro é
+// enviado em uma única transferência.
+
+#define CONTROLLER_NAME "SSD1306"
+
+static inline void controller_config(ssd1306_t *ssd) {
+  transport_command(ssd, SET_DISP | 0x00);
+  transport_command(ssd, SET_MEM_ADDR);
+  transport_command(ssd, 0x00); // endereçamento horizontal (página por página)
+  transport_command(ssd, SET_DISP_START_LINE | 0x00);
+  transport_command(ssd, SET_SEG_REMAP | 0x01);
+  transport_command(ssd, SET_MUX_RATIO);
+  transport_command(ssd, ssd->height - 1);
+  transport_command(ssd, SET_COM_OUT_DIR | 0x08);
+  transport_command(ssd, SET_DISP_OFFSET);
+  transport_command(ssd, 0x00);
+  transport_command(ssd, SET_COM_PIN_CFG);
+  transport_command(ssd, ssd->height == 32 ? 0x02 : 0x12); // painéis de 32 linhas usam COM sequencial
+  transport_command(ssd, SET_DISP_CLK_DIV);
+  transport_command(ssd, 0x80);
+  transport_command(ssd, SET_PRECHARGE);
+  transport_command(ssd, ssd->external_vcc ? 0x22 : 0xF1);
+  transport_command(ssd, SET_VCOM_DESEL);
+  transport_command(ssd, 0x30);
+  transport_command(ssd, SET_CONTRAST);
+  transport_command(ssd, 0xFF);
+  transport_command(ssd, SET_ENTIRE_ON);
+  transport_command(ssd, SET_NORM_INV);
+  transport_command(ssd, SET_CHARGE_PUMP);
+  transport_command(ssd, ssd->external_vcc ? 0x10 : 0x14);
+  transport_command(ssd, SET_DISP | 0x01);
+}
+
+static inline void controller_flush(ssd1306_t *ssd) {
+  transport_command(ssd, SET_COL_ADDR);
+  transport_command(ssd, 0);
+  transport_command(ssd, ssd->width - 1);
+  transport_command(ssd, SET_PAGE_ADDR);
+  transport_command(ssd, 0);
+  transport_command(ssd, ssd->pages - 1);
+  transport_data(ssd, ssd->ram_buffer + 1, ssd->bufsize - 1);
+}
+
+#endif
@@ -1,7 +1,7 @@
 
 // Fontes para A-Z e 0-9. Os caracteres tem 8x8 pixels
 
-static uint8_t font[] = {
+static const uint8_t font[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // Nothing
     0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e, 0x00, //0
     0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00, //1
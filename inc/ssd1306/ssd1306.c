@@ -1,75 +1,97 @@
+#include <string.h>
 #include "inc/ssd1306/ssd1306.h"
 #include "inc/ssd1306/font.h"
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+// Barramento e controlador escolhidos em tempo de compilação (ssd1306_backend.h)
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+#include "inc/ssd1306/transport_spi.h"
+#else
+#include "inc/ssd1306/transport_i2c.h"
+#endif
+
+#if DISPLAY_CONTROLLER == DISPLAY_CONTROLLER_SH1106
+#include "inc/ssd1306/controller_sh1106.h"
+#else
+#include "inc/ssd1306/controller_ssd1306.h"
+#endif
+
+// Parte comum da inicialização: geometria e framebuffer
+static bool ssd1306_init_buffer(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc) {
+  // O buffer é fornecido pela instância (SSD1306_DEFINE) e deve comportar o display
+  if (ssd->ram_buffer == NULL || ssd->bufsize < SSD1306_BUFSIZE(width, height))
+    return false;
+
   ssd->width = width;
   ssd->height = height;
   ssd->pages = height / 8U;
-  ssd->address = address;
-  ssd->i2c_port = i2c;
-  ssd->bufsize = ssd->pages * ssd->width + 1;
-  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  ssd->external_vcc = external_vcc;
+  ssd->bufsize = SSD1306_BUFSIZE(width, height);
+  memset(ssd->ram_buffer, 0, ssd->bufsize);
   ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+  return true;
+}
+
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+bool ssd1306_init_spi(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, spi_inst_t *spi, uint8_t cs_pin, uint8_t dc_pin) {
+  if (!ssd1306_init_buffer(ssd, width, height, external_vcc))
+    return false;
+
+  int channel = dma_claim_unused_channel(false);
+  if (channel < 0)
+    return false;
+
+  ssd->spi_port = spi;
+  ssd->cs_pin = cs_pin;
+  ssd->dc_pin = dc_pin;
+  ssd->dma_channel = (uint)channel;
+
+  gpio_init(cs_pin);
+  gpio_set_dir(cs_pin, GPIO_OUT);
+  gpio_put(cs_pin, 1);
+  gpio_init(dc_pin);
+  gpio_set_dir(dc_pin, GPIO_OUT);
+  return true;
+}
+#else
+bool ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+  if (!ssd1306_init_buffer(ssd, width, height, external_vcc))
+    return false;
+
+  ssd->address = address;
+  ssd->i2c_port = i2c;
+  return true;
 }
+#endif
 
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  controller_config(ssd);
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
-  ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->port_buffer,
-    2,
-    false
-  );
+  transport_command(ssd, command);
 }
 
 void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
+  controller_flush(ssd);
+}
+
+// Contraste e liga/desliga usam os mesmos comandos nos dois controladores
+void ssd1306_set_contrast(ssd1306_t *ssd, uint8_t contrast) {
+  transport_command(ssd, SET_CONTRAST);
+  transport_command(ssd, contrast);
+}
+
+void ssd1306_set_power(ssd1306_t *ssd, bool on) {
+  transport_command(ssd, SET_DISP | (on ? 0x01 : 0x00));
 }
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
+  // Pontos fora do display são ignorados (instâncias podem ter geometrias diferentes)
+  if (x >= ssd->width || y >= ssd->height)
+    return;
+
+  uint16_t index = (y >> 3) * ssd->width + x + 1;
   uint8_t pixel = (y & 0b111);
   if (value)
     ssd->ram_buffer[index] |= (1 << pixel);
@@ -78,12 +100,8 @@ void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
 }
 
 void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
-    }
+    // Preenche todas as páginas de uma vez (o primeiro byte é reservado ao barramento)
+    memset(ssd->ram_buffer + 1, value ? 0xFF : 0x00, ssd->bufsize - 1);
 }
 
 void ssd1306_rect(ssd1306_t *ssd, uint8_t left, uint8_t top, uint8_t width, uint8_t height, bool value, bool fill) {
@@ -1,10 +1,23 @@
+#ifndef __SSD1306_INC
+#define __SSD1306_INC
+
 #include <stdlib.h>
 #include "pico/stdlib.h"
-#include "hardware/i2c.h"
+#include "inc/ssd1306/ssd1306_backend.h"
 
 #define WIDTH 128
 #define HEIGHT 64
 
+// Tamanho, em bytes, do buffer de um display. O framebuffer é organizado por
+// páginas (8 linhas por byte) e é precedido de um byte reservado ao barramento.
+#define SSD1306_BUFSIZE(width, height) ((width) * ((height) / 8U) + 1)
+
+// Declara uma instância do display com o buffer alocado estaticamente.
+// Ex.: SSD1306_DEFINE(ssd, WIDTH, HEIGHT);
+#define SSD1306_DEFINE(name, width, height)                             \
+  static uint8_t name##_ram_buffer[SSD1306_BUFSIZE(width, height)];     \
+  ssd1306_t name = { .ram_buffer = name##_ram_buffer, .bufsize = sizeof(name##_ram_buffer) }
+
 typedef enum {
   SET_CONTRAST = 0x81,
   SET_ENTIRE_ON = 0xA4,
@@ -26,18 +39,31 @@ typedef enum {
 } ssd1306_command_t;
 
 typedef struct {
-  uint8_t width, height, pages, address;
+  uint8_t width, height, pages;
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+  spi_inst_t *spi_port;
+  uint8_t cs_pin, dc_pin;
+  uint dma_channel;
+#else
+  uint8_t address;
   i2c_inst_t *i2c_port;
+#endif
   bool external_vcc;
   uint8_t *ram_buffer;
   size_t bufsize;
   uint8_t port_buffer[2];
 } ssd1306_t;
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+bool ssd1306_init_spi(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, spi_inst_t *spi, uint8_t cs_pin, uint8_t dc_pin);
+#else
+bool ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+#endif
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_set_contrast(ssd1306_t *ssd, uint8_t contrast);
+void ssd1306_set_power(ssd1306_t *ssd, bool on);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
@@ -46,4 +72,6 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
\ No newline at end of file
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef __SSD1306_BACKEND_INC
+#define __SSD1306_BACKEND_INC
+
+// Seleção, em tempo de compilação, do controlador e do barramento do display.
+// Definidos pelo CMake (DISPLAY_CONTROLLER / DISPLAY_TRANSPORT); o padrão é o
+// SSD1306 por I2C da BitDogLab.
+
+#define DISPLAY_CONTROLLER_SSD1306 1
+#define DISPLAY_CONTROLLER_SH1106 2
+
+#define DISPLAY_TRANSPORT_I2C 1
+#define DISPLAY_TRANSPORT_SPI 2
+
+#ifndef DISPLAY_CONTROLLER
+#define DISPLAY_CONTROLLER DISPLAY_CONTROLLER_SSD1306
+#endif
+
+#ifndef DISPLAY_TRANSPORT
+#define DISPLAY_TRANSPORT DISPLAY_TRANSPORT_I2C
+#endif
+
+#if DISPLAY_CONTROLLER != DISPLAY_CONTROLLER_SSD1306 && DISPLAY_CONTROLLER != DISPLAY_CONTROLLER_SH1106
+#error "DISPLAY_CONTROLLER inválido"
+#endif
+
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_I2C
+#include "hardware/i2c.h"
+#elif DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+#include "hardware/spi.h"
+#else
+#error "DISPLAY_TRANSPORT inválido"
+#endif
+
+#endif
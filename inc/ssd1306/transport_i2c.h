@@ -0,0 +1,21 @@
+#ifndef __SSD1306_TRANSPORT_I2C_INC
+#define __SSD1306_TRANSPORT_I2C_INC
+
+// Barramento I2C. Cada comando vai precedido do byte de controle 0x80 e os
+// dados do byte 0x40, que ocupa a posição anterior ao trecho enviado.
+
+static inline void transport_command(ssd1306_t *ssd, uint8_t command) {
+  ssd->port_buffer[1] = command;
+  i2c_write_blocking(ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false);
+}
+
+// Envia len bytes a partir de data. data[-1] é usado temporariamente para o byte de controle.
+static inline void transport_data(ssd1306_t *ssd, uint8_t *data, size_t len) {
+  uint8_t saved = data[-1];
+
+  data[-1] = 0x40;
+  i2c_write_blocking(ssd->i2c_port, ssd->address, data - 1, len + 1, false);
+  data[-1] = saved;
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef __SSD1306_TRANSPORT_SPI_INC
+#define __SSD1306_TRANSPORT_SPI_INC
+
+// Barramento SPI (4 fios). O pino DC seleciona comando (0) ou dado (1) e os
+// dados do framebuffer são enviados por DMA.
+
+#include "hardware/dma.h"
+
+// Aguarda o fim da transmissão (FIFO vazia) e libera o CS
+static inline void transport_spi_finish(ssd1306_t *ssd) {
+  while (spi_is_busy(ssd->spi_port))
+    tight_loop_contents();
+  gpio_put(ssd->cs_pin, 1);
+}
+
+static inline void transport_command(ssd1306_t *ssd, uint8_t command) {
+  gpio_put(ssd->dc_pin, 0);
+  gpio_put(ssd->cs_pin, 0);
+  spi_write_blocking(ssd->spi_port, &command, 1);
+  transport_spi_finish(ssd);
+}
+
+static inline void transport_data(ssd1306_t *ssd, uint8_t *data, size_t len) {
+  dma_channel_config c = dma_channel_get_default_config(ssd->dma_channel);
+
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+  channel_config_set_dreq(&c, spi_get_dreq(ssd->spi_port, true));
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+
+  gpio_put(ssd->dc_pin, 1);
+  gpio_put(ssd->cs_pin, 0);
+  dma_channel_configure(ssd->dma_channel, &c, &spi_get_hw(ssd->spi_port)->dr, data, len, true);
+  dma_channel_wait_for_finish_blocking(ssd->dma_channel);
+  transport_spi_finish(ssd);
+}
+
+#endif
@@ -1,13 +1,22 @@
 #include <stdio.h>
 #include <stdlib.h> 
+#include <string.h>
 #include <math.h>
 
 #include "pico/stdlib.h"
 
 #include "hardware/adc.h"
+#include "hardware/sync.h"
 
+#include "inc/audio/level.h"
+#include "inc/audio/recorder.h"
+#include "inc/config/config.h"
+#include "inc/config/config_flash.h"
 #include "inc/display/display.h"
+#include "inc/display/mirror.h"
 #include "inc/matriz/neopixel.h"
+#include "inc/matriz/animation.h"
+#include "inc/power/governor.h"
 
 // Definição de parâmetros para o protocolo I2C
 #define I2C_ID i2c1
@@ -16,6 +25,14 @@
 #define I2C_SCL 15
 #define SSD_1306_ADDR 0x3C
 
+// Definição de parâmetros para displays conectados por SPI (DISPLAY_TRANSPORT=SPI)
+#define SPI_ID spi0
+#define SPI_FREQ 10000000
+#define SPI_SCK 18
+#define SPI_MOSI 19
+#define SPI_CS 17
+#define SPI_DC 16
+
 // Define os pinos dos botões
 #define BTN_A 5
 #define BTN_B 6
@@ -35,16 +52,29 @@
 #define PAGE_DEFINE_LEVEL 2
 #define PAGE_CONFIGURATION 3
 
-// Define os valores máximo e mínimo para configuração
-#define DB_MIN 0
-#define DB_MAX 150
+// Instâncias do display OLED e da matriz de LEDs (buffers alocados estaticamente)
+SSD1306_DEFINE(ssd, WIDTH, HEIGHT);
+NP_STRIP_DEFINE(matrix, LED_COUNT);
+
+// Reprodutor das animações da matriz (quadros na flash enviados por DMA)
+np_player_t matrix_player;
+
+// O DMA da matriz lê os quadros da flash: fica parado enquanto a configuração é gravada
+static bool matrix_was_playing;
+
+static void matrix_flash_before(void *ctx) {
+    matrix_was_playing = npPlayerPause((np_player_t *) ctx);
+}
+
+static void matrix_flash_after(void *ctx) {
+    npPlayerResume((np_player_t *) ctx, matrix_was_playing);
+}
 
-// Define os valores para a progress-bar
-#define MAX_DB 150                
-#define PROGRESS_BAR_X 0          
-#define PROGRESS_BAR_Y 20       
-#define PROGRESS_BAR_WIDTH 82 
-#define PROGRESS_BAR_HEIGHT 16
+static const config_flash_hooks_t matrix_flash_hooks = {
+    .before = matrix_flash_before,
+    .after = matrix_flash_after,
+    .ctx = &matrix_player,
+};
 
 // Define e inicializa variável que armazena o item atual do menu principal
 //  0 => item de vizualização
@@ -62,30 +92,71 @@ static volatile uint current_screen = 0;
 // Define variável para debounce do botão
 volatile uint32_t last_time_btn_press = 0;
 
-// Define e inicializa a variável que armazena o valor limite em dB definido pelo usuáriu
-uint db_value_boundary = 60;
+// Configurações ajustáveis (limite em dB, LEDs, janela de medição e brilho), gravadas na flash.
+// A interrupção dos botões altera a configuração; o laço principal trabalha sobre uma cópia
+// consistente (settings), obtida no início de cada iteração.
+config_store_t config;
+config_values_t settings;
 
 // Define e inicializa, em dB, o valor medido pelo microfone MAX4466
 uint db_value = 0;
 
 // Define variável que armazena o texto que será exibido na página de visualização
 char db_string[10];
-char db_measured_string[10];
 
 volatile uint16_t peak_to_peak = 0;
-volatile uint16_t signal_max = 0;
-volatile uint16_t signal_min = 4095;
 
-// Define e armazena o estado do botão A
-volatile bool btn_a_state = true;
+// Última leitura do microfone (com os indicadores de saturação e de sinal abaixo da faixa)
+// e piso de ruído acompanhado ao longo das medições
+level_reading_t reading;
+level_noise_t noise;
 
 // Define os itens do menu principal
 const char *menu_itens[] = {
     "VIZUALIZAR", "DEF NIVEL", "CONFIGURAR"
 };
 
-const uint32_t sample_window = 50;  // Sample window width in mS (50 mS = 20Hz)
-uint16_t sample;
+// Intervalo entre os relatórios de permanência do governador
+#define GOVERNOR_REPORT_MS 60000
+
+// Governador de atualização e baixo consumo
+governor_t governor;
+
+#ifdef DECIMETER_MIRROR
+#include "inc/display/mirror_usb.h"
+
+// Espelhamento do display para o visualizador no computador (tools/fbviewer)
+#define MIRROR_INTERVAL_MS 200
+#define MIRROR_KEYFRAME_EVERY 25
+
+mirror_t mirror;
+static char mirror_line[MIRROR_MAX_LINE];
+
+// Envia o quadro capturado. Fora do caminho de desenho e sem esperar pela USB:
+// a linha é enviada aos poucos, conforme a FIFO do CDC esvazia (mirror_usb.h)
+void mirror_service() {
+    mirror_usb_service();
+    // Linha descartada sem computador conectado: o próximo quadro precisa ser chave
+    if (mirror_usb_take_lost()) {
+        mirror_request_keyframe(&mirror);
+    }
+    if (!mirror_usb_idle()) {
+        return;
+    }
+
+    size_t len = mirror_encode(&mirror, mirror_line, sizeof(mirror_line));
+    if (len > 0) {
+        mirror_usb_send(mirror_line, len);
+    }
+}
+#endif
+
+#ifdef DECIMETER_TELEMETRY
+#include "inc/net/telemetry_udp.h"
+
+// Telemetria dos níveis por UDP (tools/telemetry). Rede, destino e intervalo vêm do CMake
+telemetry_t telemetry;
+#endif
 
 // Configura e inicializa os botões
 void btn_setup(uint gpio) {
@@ -101,11 +172,23 @@ void peripheral_setup() {
     btn_setup(BTN_B);
     btn_setup(BTN_SW);
 
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+    // Chama a função para configuração do protocolo SPI (utilizado na comunicação com o display)
+    spi_setup(SPI_ID, SPI_FREQ, SPI_SCK, SPI_MOSI);
+
+    // Inicializa o display
+    if (!display_setup_spi(&ssd, SPI_ID, SPI_CS, SPI_DC)) {
+        panic("Falha ao inicializar o display\n");
+    }
+#else
     // Chama a função para configuração do protocolo I2C (utilizado na comunicação com o display)
     i2c_setup(I2C_ID, I2C_FREQ, I2C_SDA, I2C_SCL);
     
     // Inicializa o display
-    display_setup(SSD_1306_ADDR, I2C_ID);
+    if (!display_setup(&ssd, SSD_1306_ADDR, I2C_ID)) {
+        panic("Falha ao inicializar o display\n");
+    }
+#endif
 }
 
 // Configuração do ADC
@@ -115,69 +198,41 @@ void adc_setup() {
     adc_select_input(MIC_CHANNEL);
 }
 
-// Atualiza a barra de progresso
-void update_progress_bar(uint db_value) {
-    // Limita o valor mínimo
-    if (db_value < 0) {
-        db_value = 0;
-    }
-
-     // Limita o valor máximo
-    if (db_value > MAX_DB) { 
-        db_value = MAX_DB;
-    }
-
-    // Determina o comprimento da barra que estará preenchida
-    uint filled_width = (db_value * PROGRESS_BAR_WIDTH) / MAX_DB;
-
-    // Desenha o contorno da barra de progresso na tela de visualização
-    ssd1306_rect(&ssd, PROGRESS_BAR_X, PROGRESS_BAR_Y, PROGRESS_BAR_WIDTH, PROGRESS_BAR_HEIGHT, true, false);
-
-    // Draw the filled part based on current intensity
-    ssd1306_rect(&ssd, PROGRESS_BAR_X, PROGRESS_BAR_Y, filled_width, PROGRESS_BAR_HEIGHT, true, true);
-}
-
 // Define função que exibe a p´ágina selecionada no GUI
 void call_page(uint page_selected) {
     if (page_selected == PAGE_MENU) {
         if (current_menu_item == 0) {
             ssd1306_draw_string(&ssd, menu_itens[current_menu_item], 25, 34); // Desenha uma string
-            display_draw_right_arrow();
+            display_draw_right_arrow(&ssd);
             ssd1306_send_data(&ssd);
         } else if (current_menu_item == 1) {
             ssd1306_draw_string(&ssd, menu_itens[current_menu_item], 25, 34); // Desenha uma string
-            display_draw_left_arrow();
-            display_draw_right_arrow();
+            display_draw_left_arrow(&ssd);
+            display_draw_right_arrow(&ssd);
             ssd1306_send_data(&ssd);
         } else if (current_menu_item == 2) {
             ssd1306_draw_string(&ssd, menu_itens[current_menu_item], 25, 34); // Desenha uma string
-            display_draw_left_arrow();
+            display_draw_left_arrow(&ssd);
             ssd1306_send_data(&ssd);
         }
     } else if (page_selected == PAGE_DEFINE_LEVEL) {
-        display_draw_back_arrow();
-        display_draw_plus_btn();
-        display_draw_minus_btn();
+        display_draw_back_arrow(&ssd);
+        display_draw_plus_btn(&ssd);
+        display_draw_minus_btn(&ssd);
     
-        snprintf(db_string, sizeof(db_string), "%ddB", db_value_boundary);
+        snprintf(db_string, sizeof(db_string), "%ddB", settings.db_boundary);
     
         ssd1306_draw_string(&ssd, db_string, 44, 33);
         ssd1306_send_data(&ssd);
     } else if (page_selected == PAGE_MEASUREMENT) {
-        // Adiciona o botão de voltar na GUI
-        display_draw_back_arrow();
-        // Atualiza a barra de progresso
-        update_progress_bar(db_value);
-
-        // Cria a string que é exibida ao lado da barra de progresso. Exibe o valor medido em tempo real (dB)
-        snprintf(db_measured_string, sizeof(db_measured_string), "%ddB", db_value);
-        ssd1306_draw_string(&ssd, db_measured_string, 84, 25); 
+        // Desenha a barra de progresso e o valor medido em tempo real (dB)
+        display_draw_measurement(&ssd, db_value, reading.flags);
         ssd1306_send_data(&ssd);
     } else if (page_selected == PAGE_CONFIGURATION) {
-        display_draw_back_arrow();
-        display_draw_led_on_btn(btn_a_state);
+        display_draw_back_arrow(&ssd);
+        display_draw_led_on_btn(&ssd, settings.led_enabled);
 
-        if (btn_a_state) {
+        if (settings.led_enabled) {
             ssd1306_draw_string(&ssd, "LED LIGADO", 0, 33); // valor medido em tempo real
         } else {
             ssd1306_draw_string(&ssd, "LED DESLIGADO", 0, 33); // valor medido em tempo real
@@ -188,31 +243,20 @@ void call_page(uint page_selected) {
     }
 }
 
-// Realiza a medição do microfone
-uint mic_measurement() {
+// Realiza a medição do microfone, acumulando as amostras em window
+void mic_measurement(uint32_t window_ms, level_window_t *window) {
     uint32_t current_time = to_ms_since_boot(get_absolute_time());
-    peak_to_peak = 0;
-    signal_max = 0;
-    signal_min = 4095;
-
-    while((to_ms_since_boot(get_absolute_time()) - current_time) < sample_window) {
-        sample = adc_read();
-
-        if (sample < 4095) {
-            if (sample > signal_max) {
-                signal_max = sample;  
-            } else if (sample < signal_min) {
-                signal_min = sample; 
-            }
-        }
-    }
 
-    return (signal_max - signal_min);
-}
+    level_window_reset(window);
+    recorder_begin();
+
+    while((to_ms_since_boot(get_absolute_time()) - current_time) < window_ms) {
+        uint16_t sample = adc_read();
+        recorder_sample(sample);
+        level_window_push(window, sample);
+    }
 
-// Converte o valor pico a pico para dB
-uint convert_to_db(uint16_t peak_to_peak) {
-    return ((uint) round(20.0 * log10((double) peak_to_peak)));   
+    recorder_end(settings.db_boundary, settings.led_enabled);
 }
 
 // Função que trata das interrupções geradas pelos botões
@@ -222,18 +266,31 @@ void irq_handler(uint gpio, uint32_t events) {
     if (current_time - last_time_btn_press > 260) {
         last_time_btn_press = current_time;
 
+        // Com o display desligado, o botão apenas acorda o sistema
+        bool asleep = governor.state == GOVERNOR_SLEEP;
+        governor_notify_input(&governor);
+        if (asleep) {
+            return;
+        }
+
         if (gpio == BTN_A) {
             if (current_screen == 0) {
                 if (current_menu_item > 0) {
                     current_menu_item = current_menu_item - 1;
                 }
             } else if (current_screen == 2) {
-                if (db_value_boundary > DB_MIN) {
-                    db_value_boundary = db_value_boundary - 1;
-                    printf("db: %d\n", db_value_boundary);
+                config_values_t values;
+                config_read(&config, &values);
+                if (values.db_boundary > CONFIG_DB_MIN) {
+                    values.db_boundary = values.db_boundary - 1;
+                    config_write(&config, &values);
+                    printf("db: %d\n", values.db_boundary);
                 }
             } else if (current_screen == 3) {
-                btn_a_state = !btn_a_state;
+                config_values_t values;
+                config_read(&config, &values);
+                values.led_enabled = !values.led_enabled;
+                config_write(&config, &values);
             }
         } else if (gpio == BTN_B) {
             if (current_screen == 0) {
@@ -241,9 +298,12 @@ void irq_handler(uint gpio, uint32_t events) {
                     current_menu_item = current_menu_item + 1;
                 }
             } else if (current_screen == 2) {
-                if (db_value_boundary < DB_MAX) {
-                    db_value_boundary = db_value_boundary + 1;
-                    printf("db: %d\n", db_value_boundary);
+                config_values_t values;
+                config_read(&config, &values);
+                if (values.db_boundary < CONFIG_DB_MAX) {
+                    values.db_boundary = values.db_boundary + 1;
+                    config_write(&config, &values);
+                    printf("db: %d\n", values.db_boundary);
                 }
             } 
         } else if (gpio == BTN_SW) {
@@ -266,15 +326,76 @@ void irq_handler(uint gpio, uint32_t events) {
     }
 }
 
+// Comandos de configuração pela serial, uma linha por comando:
+//   CFG                 exibe a configuração atual
+//   CFG limite=70       altera um campo (limite, led, janela ou brilho)
+void config_command_poll() {
+    static char line[32];
+    static uint len = 0;
+    int c;
+
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+        if (c != '\r' && c != '\n') {
+            if (len < sizeof(line) - 1) {
+                line[len++] = (char)c;
+            }
+            continue;
+        }
+
+        line[len] = '\0';
+        len = 0;
+        if (strncmp(line, "CFG", 3) != 0) {
+            continue;
+        }
+
+        char name[12];
+        long value;
+        if (sscanf(line + 3, " %11[a-z]=%ld", name, &value) == 2) {
+            // Fora da interrupção dos botões, a escrita é feita com as interrupções desligadas
+            uint32_t irq = save_and_disable_interrupts();
+            config_values_t values;
+            config_read(&config, &values);
+            bool ok = config_set_field(&values, name, value);
+            if (ok) {
+                config_write(&config, &values);
+            }
+            restore_interrupts(irq);
+
+            if (!ok) {
+                printf("CONFIG: campo desconhecido: %s\n", name);
+                continue;
+            }
+            governor_notify_input(&governor);
+        }
+
+        char text[64];
+        config_values_t values;
+        config_read(&config, &values);
+        config_format(&values, text, sizeof(text));
+        printf("CONFIG: %s\n", text);
+    }
+}
+
 int main() {
     // Chama função para comunicação serial via usb para depuração
     stdio_init_all(); 
+#ifdef DECIMETER_MIRROR
+    // A saída de texto passa a dividir a USB com o espelhamento sem esperar pelo computador
+    mirror_usb_init();
+#endif
 
     // Inicializa os periféricos: botões A, B e SW; display ssd1306
     peripheral_setup();
 
+    // Carrega a configuração gravada na flash (ou os valores padrão)
+    char config_text[64];
+    bool config_loaded = config_init(&config, &config_flash_backend, &config_defaults);
+    config_read(&config, &settings);
+    config_format(&settings, config_text, sizeof(config_text));
+    printf("CONFIG: %s (%s)\n", config_text, config_loaded ? "flash" : "padrao");
+
     // Desenha a GUI no display
-    display_draw_main_layout();
+    display_draw_main_layout(&ssd);
 
     // Insere o texto de inicialização na GUI
     ssd1306_rect(&ssd, 0, 14, 128, 50, false, true);
@@ -297,18 +418,26 @@ int main() {
     ssd1306_send_data(&ssd);
 
     // Inicializa e limpa a matriz de LEDs
-    npInit(LED_PIN, LED_COUNT);
-    npClear();
+    if (!npInit(&matrix, LED_PIN)) {
+        panic("Falha ao inicializar a matriz de LEDs\n");
+    }
+    if (!npPlayerInit(&matrix_player, &matrix)) {
+        panic("Falha ao inicializar as animações da matriz de LEDs\n");
+    }
+    config_flash_set_hooks(&matrix_flash_hooks);
+    // Varredura de teste da matriz enquanto a tela de configuração é exibida
+    npPlayerPlay(&matrix_player, &np_anim_sweep, 0);
     sleep_ms(1500);
+    npPlayerPlay(&matrix_player, &np_anim_off, 0);
     
-    snprintf(db_string, sizeof(db_string), "%udB", db_value_boundary);
+    snprintf(db_string, sizeof(db_string), "%udB", settings.db_boundary);
 
     ssd1306_draw_string(&ssd, db_string, 83, 3); 
     ssd1306_send_data(&ssd);
 
     // Desenha a GUI do menu principal
-    display_clean_main_area();    
-    display_draw_right_arrow();
+    display_clean_main_area(&ssd);    
+    display_draw_right_arrow(&ssd);
     ssd1306_draw_string(&ssd, menu_itens[current_menu_item], 25, 34);
     ssd1306_send_data(&ssd);
 
@@ -317,31 +446,151 @@ int main() {
     gpio_set_irq_enabled(BTN_B, GPIO_IRQ_EDGE_FALL, true);
     gpio_set_irq_enabled(BTN_SW, GPIO_IRQ_EDGE_FALL, true);
 
+    governor_init(&governor, &governor_default_config, to_ms_since_boot(get_absolute_time()));
+#ifdef DECIMETER_MIRROR
+    mirror_init(&mirror, WIDTH, HEIGHT, MIRROR_INTERVAL_MS, MIRROR_KEYFRAME_EVERY);
+#endif
+#ifdef DECIMETER_TELEMETRY
+    telemetry_init(&telemetry, DECIMETER_TELEMETRY_INTERVAL_MS, to_ms_since_boot(get_absolute_time()));
+    if (!telemetry_udp_init(DECIMETER_WIFI_SSID, DECIMETER_WIFI_PASSWORD, DECIMETER_TELEMETRY_HOST,
+                            DECIMETER_TELEMETRY_PORT, to_ms_since_boot(get_absolute_time()))) {
+        printf("TELEMETRIA: falha ao iniciar o Wi-Fi\n");
+    }
+#endif
+    uint8_t applied_contrast = governor_contrast(&governor);
+    bool display_on = true;
+    level_alarm_level_t alarm_on = LEVEL_ALARM_NONE;
+    uint32_t last_report = to_ms_since_boot(get_absolute_time());
+    char governor_report[96];
+    uint32_t overload_windows = 0, measured_windows = 0;
+    level_noise_reset(&noise);
+
     while(true) {
-        // Limpa o buffer da área principal
-        display_clean_main_area();
-        // Exibe a página atual na GUI
-        call_page(current_screen);
-        // Chama a função que atualiza o valor, em dB, que é exibido no cabeçalho
-        ssd1306_rect(&ssd, 79, 1, 45, 11, false, true);
-        snprintf(db_string, sizeof(db_string), "%udB", db_value_boundary);
-        ssd1306_draw_string(&ssd, db_string, 83, 3);
-        // Realiza a medição do microfone 
-        peak_to_peak = mic_measurement();
-        db_value = convert_to_db(peak_to_peak);
-        // Limpa a matriz de LEDs
-        npClear();
-
-        if (db_value > db_value_boundary && btn_a_state) {
-            for (uint i = 0; i < LED_COUNT; i++) {
-                npSetLED(i, 80, 0, 0);
-            }
+        uint32_t now = to_ms_since_boot(get_absolute_time());
+
+        // Cópia consistente da configuração para esta iteração
+        config_read(&config, &settings);
+
+        // O brilho configurado vale para o uso normal; o modo reduzido nunca fica mais claro que ele
+        governor.cfg.contrast[GOVERNOR_ACTIVE] = settings.brightness;
+        governor.cfg.contrast[GOVERNOR_STABLE] = settings.brightness;
+        governor.cfg.contrast[GOVERNOR_DIM] = settings.brightness < governor_default_config.contrast[GOVERNOR_DIM]
+            ? settings.brightness : governor_default_config.contrast[GOVERNOR_DIM];
+
+        // Atualiza o governador com a última medição. O limite definido pelo usuário acorda o sistema,
+        // assim como uma janela saturada (db_value guarda apenas o último nível válido)
+        governor.cfg.wake_db = settings.db_boundary;
+        governor_state_t previous_state = governor.state;
+        unsigned int governor_db = reading.flags & LEVEL_FLAG_OVERLOAD ? GOVERNOR_DB_OVERLOAD : db_value;
+        if (governor_update(&governor, now, governor_db) != previous_state) {
+            printf("GOVERNADOR: %s\n", governor_state_name(governor.state));
+        }
+
+        // Aplica o brilho e o estado do display
+        if (governor_display_on(&governor) != display_on) {
+            display_on = governor_display_on(&governor);
+            ssd1306_set_power(&ssd, display_on);
+        }
+        if (governor_contrast(&governor) != applied_contrast) {
+            applied_contrast = governor_contrast(&governor);
+            ssd1306_set_contrast(&ssd, applied_contrast);
+        }
+
+        bool refresh = governor_refresh_due(&governor, now);
+        if (refresh) {
+            // Limpa o buffer da área principal
+            display_clean_main_area(&ssd);
+            // Atualiza o valor limite, em dB, do cabeçalho antes do envio, para que vá no mesmo quadro
+            display_draw_header_level(&ssd, settings.db_boundary);
+            // Exibe a página atual na GUI (desenha e envia o quadro ao display)
+            call_page(current_screen);
+#ifdef DECIMETER_MIRROR
+            // Copia o quadro que acabou de ser enviado ao display
+            mirror_capture(&mirror, ssd.ram_buffer + 1, current_screen, now);
+#endif
         }
 
-        // Escreve o buffer na matriz de LEDs
-        npWrite();
-        sleep_ms(80);
+        // Realiza a medição do microfone (janela curta no modo de vigília)
+        level_window_t window;
+        mic_measurement(governor_sample_window_ms(&governor, settings.sample_window_ms), &window);
+
+        // Leituras com o ADC saturado são descartadas: o último nível válido é mantido
+        unsigned int previous_flags = reading.flags;
+        level_reading_update(&reading, &window);
+        if (reading.valid) {
+            peak_to_peak = reading.peak_to_peak;
+            db_value = reading.db;
+            level_noise_update(&noise, reading.peak_to_peak);
+        } else {
+            overload_windows++;
+        }
+        measured_windows++;
+
+        if (reading.flags != previous_flags) {
+            printf("NIVEL: saturado %s, abaixo da faixa %s (amostras saturadas %lu, DC %u)\n",
+                   reading.flags & LEVEL_FLAG_OVERLOAD ? "sim" : "nao",
+                   reading.flags & LEVEL_FLAG_UNDERRANGE ? "sim" : "nao",
+                   (unsigned long)(window.clip_high + window.clip_low), level_window_dc_offset(&window));
+        }
+
+        // A animação da matriz só é trocada quando o nível de alarme muda ou na atualização da GUI.
+        // Os quadros seguintes são enviados pelo alarme de hardware, sem passar pelo laço principal
+        uint8_t alarm_amount;
+        level_alarm_level_t alarm = level_alarm_level(&reading, settings.db_boundary, settings.led_enabled, &alarm_amount);
+        if (refresh || alarm != alarm_on) {
+            alarm_on = alarm;
+            npPlayerAlarm(&matrix_player, alarm, alarm_amount);
+        }
+
+#ifdef DECIMETER_MIRROR
+        mirror_service();
+#endif
+
+#ifdef DECIMETER_TELEMETRY
+        // Um registro por medição; o envio é em lotes e nunca espera pela rede
+        telemetry_record_t record = {
+            .t_ms = now,
+            .peak_to_peak = reading.peak_to_peak,
+            .db = (uint8_t) reading.db,
+            .flags = (uint8_t) reading.flags,
+            .alarm = (uint8_t) alarm,
+        };
+        telemetry_push(&telemetry, &record);
+        telemetry_udp_service(&telemetry, now);
+#endif
+
+        // Comandos de configuração pela serial e gravação da configuração na flash, depois
+        // que os ajustes param (a gravação nunca ocorre durante uma medição)
+        config_command_poll();
+        config_service_result_t saved = config_service(&config, now);
+        if (saved != CONFIG_IDLE) {
+            printf("CONFIG: %s (gravacoes %lu, falhas %lu)\n", saved == CONFIG_SAVED ? "gravada" : "falha ao gravar",
+                   (unsigned long)config.saves, (unsigned long)config.failures);
+        }
+
+        // Relatório periódico de permanência em cada estado
+        if (now - last_report >= GOVERNOR_REPORT_MS) {
+            last_report = now;
+            governor_format_residency(&governor, governor_report, sizeof(governor_report));
+            printf("GOVERNADOR: %s\n", governor_report);
+            printf("NIVEL: piso de ruido %u, faixa dinamica %udB, saturadas %lu de %lu janelas\n",
+                   level_noise_floor(&noise), level_dynamic_range_db(&noise),
+                   (unsigned long)overload_windows, (unsigned long)measured_windows);
+            overload_windows = 0;
+            measured_windows = 0;
+        }
+
+        // Aguarda até a próxima medição. Em vigília o intervalo é maior, mas um botão acorda na hora
+        uint32_t wait_ms = governor.state == GOVERNOR_SLEEP ? governor.cfg.watch_interval_ms : 80;
+        absolute_time_t until = make_timeout_time_ms(wait_ms);
+        while (!governor.input_pending && !best_effort_wfe_or_timeout(until)) {
+#ifdef DECIMETER_MIRROR
+            // A tarefa USB do SDK acorda o núcleo a cada milissegundo: continua o envio
+            mirror_usb_service();
+#endif
+            tight_loop_contents();
+        }
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,333 @@
+// Analisador offline de gravações do Decimeter.
+//
+// Processa arquivos WAV ou dumps brutos do ADC com o mesmo cálculo de nível do
+// firmware (inc/audio/level.c) e gera um resultado por janela de medição em CSV
+// ou JSON. Os arquivos são divididos em blocos de janelas e processados em paralelo.
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "inc/audio/level.h"
+#include "input.h"
+#include "kernels.h"
+#include "pool.h"
+
+// Janela de medição padrão do firmware (sample_window, em ms)
+#define DEFAULT_WINDOW_MS 50
+// Quantidade padrão de janelas por tarefa
+#define DEFAULT_CHUNK_WINDOWS 64
+
+typedef enum { OUTPUT_CSV, OUTPUT_JSON } output_format_t;
+
+// Resultado de uma janela
+typedef struct {
+  uint32_t samples;
+  uint32_t clipped;
+  uint16_t peak_to_peak;
+  uint16_t db;
+  uint16_t dc_offset;
+  uint8_t flags; // LEVEL_FLAG_*
+} interval_t;
+
+typedef struct {
+  input_t in;
+  size_t window_samples;
+  size_t windows; // apenas janelas completas, como no firmware
+  interval_t *intervals;
+  level_noise_t noise; // calculado em sequência, após o processamento paralelo
+} file_job_t;
+
+// Uma tarefa processa janelas [first_window, first_window + window_count) de um arquivo
+typedef struct {
+  file_job_t *file;
+  size_t first_window;
+  size_t window_count;
+} chunk_t;
+
+typedef struct {
+  chunk_t *chunks;
+  kernel_t kernel;
+  int verify;
+  uint16_t **scratch; // um buffer de conversão por worker
+  size_t *worker_samples;
+  volatile int mismatch;
+} run_ctx_t;
+
+static void process_chunk(void *arg, size_t task, unsigned worker) {
+  run_ctx_t *ctx = arg;
+  chunk_t *c = &ctx->chunks[task];
+  file_job_t *f = c->file;
+  uint16_t *buf = ctx->scratch[worker];
+
+  for (size_t k = 0; k < c->window_count; ++k) {
+    size_t window = c->first_window + k;
+    level_window_t w;
+
+    input_read_adc(&f->in, window * f->window_samples, f->window_samples, buf);
+
+    level_window_reset(&w);
+    ctx->kernel.fn(&w, buf, f->window_samples);
+
+    if (ctx->verify) {
+      level_window_t ref;
+      level_window_reset(&ref);
+      level_window_push_block(&ref, buf, f->window_samples);
+      if (memcmp(&ref, &w, sizeof(w)) != 0)
+        ctx->mismatch = 1;
+    }
+
+    uint16_t p2p = level_window_peak_to_peak(&w);
+    f->intervals[window].samples = w.count;
+    f->intervals[window].clipped = w.clip_high + w.clip_low;
+    f->intervals[window].peak_to_peak = p2p;
+    f->intervals[window].db = (uint16_t)level_convert_to_db(p2p);
+    f->intervals[window].dc_offset = level_window_dc_offset(&w);
+    f->intervals[window].flags = (uint8_t)level_window_flags(&w);
+  }
+
+  ctx->worker_samples[worker] += c->window_count * f->window_samples;
+}
+
+static void print_json_string(FILE *out, const char *s) {
+  fputc('"', out);
+  for (; *s; ++s) {
+    if (*s == '"' || *s == '\\')
+      fputc('\\', out);
+    if ((unsigned char)*s < 0x20)
+      fprintf(out, "\\u%04x", *s);
+    else
+      fputc(*s, out);
+  }
+  fputc('"', out);
+}
+
+static void write_csv(FILE *out, file_job_t *files, size_t nfiles, uint32_t window_ms) {
+  fprintf(out, "file,window,t_ms,samples,peak_to_peak,db,clipped,dc_offset,overload,underrange\n");
+  for (size_t i = 0; i < nfiles; ++i) {
+    for (size_t k = 0; k < files[i].windows; ++k) {
+      interval_t *r = &files[i].intervals[k];
+      // Leituras com saturação são inválidas: o nível fica em branco
+      fprintf(out, "%s,%zu,%zu,%u,", files[i].in.path, k, k * window_ms, r->samples);
+      if (r->flags & LEVEL_FLAG_OVERLOAD)
+        fprintf(out, ",,");
+      else
+        fprintf(out, "%u,%u,", r->peak_to_peak, r->db);
+      fprintf(out, "%u,%u,%d,%d\n", r->clipped, r->dc_offset, (r->flags & LEVEL_FLAG_OVERLOAD) != 0,
+              (r->flags & LEVEL_FLAG_UNDERRANGE) != 0);
+    }
+  }
+}
+
+static void write_json(FILE *out, file_job_t *files, size_t nfiles, uint32_t window_ms) {
+  fprintf(out, "[\n");
+  for (size_t i = 0; i < nfiles; ++i) {
+    fprintf(out, "  {\"file\": ");
+    print_json_string(out, files[i].in.path);
+    fprintf(out, ", \"rate\": %u, \"window_ms\": %u, \"noise_floor\": %u, \"dynamic_range_db\": %u, \"intervals\": [",
+            files[i].in.rate, window_ms, level_noise_floor(&files[i].noise), level_dynamic_range_db(&files[i].noise));
+    for (size_t k = 0; k < files[i].windows; ++k) {
+      interval_t *r = &files[i].intervals[k];
+      fprintf(out, "%s\n    {\"t_ms\": %zu, \"samples\": %u, ", k ? "," : "", k * window_ms, r->samples);
+      // Leituras com saturação são inválidas: o nível é null
+      if (r->flags & LEVEL_FLAG_OVERLOAD)
+        fprintf(out, "\"peak_to_peak\": null, \"db\": null, ");
+      else
+        fprintf(out, "\"peak_to_peak\": %u, \"db\": %u, ", r->peak_to_peak, r->db);
+      fprintf(out, "\"clipped\": %u, \"dc_offset\": %u, \"overload\": %s, \"underrange\": %s}", r->clipped,
+              r->dc_offset, r->flags & LEVEL_FLAG_OVERLOAD ? "true" : "false",
+              r->flags & LEVEL_FLAG_UNDERRANGE ? "true" : "false");
+    }
+    fprintf(out, "%s]}%s\n", files[i].windows ? "\n  " : "", i + 1 < nfiles ? "," : "");
+  }
+  fprintf(out, "]\n");
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "uso: %s [opções] arquivo...\n"
+          "  -r, --rate HZ        taxa de amostragem dos arquivos brutos do ADC\n"
+          "  -w, --window-ms MS   janela de medição (padrão %d)\n"
+          "  -j, --jobs N         quantidade de threads (padrão: núcleos disponíveis)\n"
+          "  -c, --chunk N        janelas por tarefa (padrão %d)\n"
+          "  -f, --format FMT     csv ou json (padrão csv)\n"
+          "  -o, --output ARQ     arquivo de saída (padrão stdout)\n"
+          "      --scalar         desativa os kernels vetoriais\n"
+          "      --verify         confere o kernel vetorial contra o escalar\n",
+          prog, DEFAULT_WINDOW_MS, DEFAULT_CHUNK_WINDOWS);
+}
+
+int main(int argc, char **argv) {
+  static const struct option options[] = {
+    { "rate", required_argument, NULL, 'r' },
+    { "window-ms", required_argument, NULL, 'w' },
+    { "jobs", required_argument, NULL, 'j' },
+    { "chunk", required_argument, NULL, 'c' },
+    { "format", required_argument, NULL, 'f' },
+    { "output", required_argument, NULL, 'o' },
+    { "scalar", no_argument, NULL, 'S' },
+    { "verify", no_argument, NULL, 'V' },
+    { "help", no_argument, NULL, 'h' },
+    { NULL, 0, NULL, 0 }
+  };
+  uint32_t raw_rate = 0;
+  uint32_t window_ms = DEFAULT_WINDOW_MS;
+  long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+  size_t chunk_windows = DEFAULT_CHUNK_WINDOWS;
+  output_format_t format = OUTPUT_CSV;
+  const char *output = NULL;
+  int force_scalar = 0, verify = 0;
+  int opt;
+
+  while ((opt = getopt_long(argc, argv, "r:w:j:c:f:o:h", options, NULL)) != -1) {
+    switch (opt) {
+    case 'r': raw_rate = (uint32_t)strtoul(optarg, NULL, 10); break;
+    case 'w': window_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+    case 'j': jobs = strtol(optarg, NULL, 10); break;
+    case 'c': chunk_windows = strtoul(optarg, NULL, 10); break;
+    case 'f':
+      if (strcmp(optarg, "csv") == 0) {
+        format = OUTPUT_CSV;
+      } else if (strcmp(optarg, "json") == 0) {
+        format = OUTPUT_JSON;
+      } else {
+        usage(argv[0]);
+        return 2;
+      }
+      break;
+    case 'o': output = optarg; break;
+    case 'S': force_scalar = 1; break;
+    case 'V': verify = 1; break;
+    default:
+      usage(argv[0]);
+      return opt == 'h' ? 0 : 2;
+    }
+  }
+
+  if (optind >= argc || window_ms == 0 || chunk_windows == 0) {
+    usage(argv[0]);
+    return 2;
+  }
+  if (jobs < 1)
+    jobs = 1;
+
+  size_t nfiles = (size_t)(argc - optind);
+  file_job_t *files = calloc(nfiles, sizeof(*files));
+  size_t nchunks = 0, max_window = 0;
+
+  for (size_t i = 0; i < nfiles; ++i) {
+    file_job_t *f = &files[i];
+
+    if (input_open(&f->in, argv[optind + i], raw_rate) < 0)
+      return 1;
+
+    f->window_samples = (size_t)f->in.rate * window_ms / 1000;
+    if (f->window_samples == 0) {
+      fprintf(stderr, "%s: janela menor que uma amostra\n", f->in.path);
+      return 1;
+    }
+
+    f->windows = f->in.frames / f->window_samples;
+    f->intervals = calloc(f->windows ? f->windows : 1, sizeof(interval_t));
+    nchunks += (f->windows + chunk_windows - 1) / chunk_windows;
+    if (f->window_samples > max_window)
+      max_window = f->window_samples;
+  }
+
+  // Divide os arquivos em tarefas de chunk_windows janelas
+  run_ctx_t ctx = { .kernel = kernel_select(force_scalar), .verify = verify };
+  ctx.chunks = calloc(nchunks ? nchunks : 1, sizeof(chunk_t));
+  for (size_t i = 0, n = 0; i < nfiles; ++i) {
+    for (size_t w = 0; w < files[i].windows; w += chunk_windows) {
+      ctx.chunks[n].file = &files[i];
+      ctx.chunks[n].first_window = w;
+      ctx.chunks[n].window_count = files[i].windows - w < chunk_windows ? files[i].windows - w : chunk_windows;
+      n++;
+    }
+  }
+
+  unsigned workers = (unsigned)jobs;
+  if (nchunks < workers)
+    workers = nchunks ? (unsigned)nchunks : 1;
+
+  ctx.scratch = calloc(workers, sizeof(uint16_t *));
+  ctx.worker_samples = calloc(workers, sizeof(size_t));
+  for (unsigned i = 0; i < workers; ++i)
+    ctx.scratch[i] = malloc(max_window * sizeof(uint16_t));
+
+  pool_worker_stats_t *stats = calloc(workers, sizeof(*stats));
+  uint64_t start = pool_now_ns();
+  if (pool_run(workers, nchunks, process_chunk, &ctx, stats) < 0) {
+    fprintf(stderr, "falha ao iniciar as threads\n");
+    return 1;
+  }
+  uint64_t elapsed = pool_now_ns() - start;
+
+  // O piso de ruído depende da ordem das janelas, então é acompanhado em sequência
+  for (size_t i = 0; i < nfiles; ++i) {
+    level_noise_reset(&files[i].noise);
+    for (size_t k = 0; k < files[i].windows; ++k) {
+      interval_t *r = &files[i].intervals[k];
+      if (r->samples > 0 && !(r->flags & LEVEL_FLAG_OVERLOAD))
+        level_noise_update(&files[i].noise, r->peak_to_peak);
+    }
+  }
+
+  FILE *out = stdout;
+  if (output != NULL && (out = fopen(output, "w")) == NULL) {
+    perror(output);
+    return 1;
+  }
+
+  if (format == OUTPUT_CSV)
+    write_csv(out, files, nfiles, window_ms);
+  else
+    write_json(out, files, nfiles, window_ms);
+
+  if (out != stdout)
+    fclose(out);
+
+  // Vazão: total e por núcleo (amostras / tempo ocupado de cada worker)
+  size_t total = 0;
+  for (unsigned i = 0; i < workers; ++i)
+    total += ctx.worker_samples[i];
+
+  fprintf(stderr, "kernel: %s, threads: %u, arquivos: %zu, tarefas: %zu, amostras: %zu, tempo: %.3f s\n",
+          ctx.kernel.name, workers, nfiles, nchunks, total, elapsed / 1e9);
+  fprintf(stderr, "vazão total: %.3e amostras/s\n", elapsed ? total / (elapsed / 1e9) : 0.0);
+  for (size_t i = 0; i < nfiles; ++i) {
+    size_t overload = 0, underrange = 0;
+    for (size_t k = 0; k < files[i].windows; ++k) {
+      overload += (files[i].intervals[k].flags & LEVEL_FLAG_OVERLOAD) != 0;
+      underrange += (files[i].intervals[k].flags & LEVEL_FLAG_UNDERRANGE) != 0;
+    }
+    fprintf(stderr, "%s: piso de ruído %u, faixa dinâmica %u dB, janelas saturadas %zu, abaixo da faixa %zu\n",
+            files[i].in.path, level_noise_floor(&files[i].noise), level_dynamic_range_db(&files[i].noise),
+            overload, underrange);
+  }
+  for (unsigned i = 0; i < workers; ++i) {
+    double busy = stats[i].busy_ns / 1e9;
+    fprintf(stderr, "  thread %u: %zu tarefas, %.3e amostras/s\n", i, stats[i].tasks,
+            busy > 0 ? ctx.worker_samples[i] / busy : 0.0);
+  }
+
+  if (ctx.mismatch) {
+    fprintf(stderr, "ERRO: kernel %s divergiu da referência escalar\n", ctx.kernel.name);
+    return 1;
+  }
+
+  for (size_t i = 0; i < nfiles; ++i) {
+    input_close(&files[i].in);
+    free(files[i].intervals);
+  }
+  for (unsigned i = 0; i < workers; ++i)
+    free(ctx.scratch[i]);
+  free(ctx.scratch);
+  free(ctx.worker_samples);
+  free(ctx.chunks);
+  free(stats);
+  free(files);
+  return 0;
+}
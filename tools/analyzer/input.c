@@ -0,0 +1,144 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "input.h"
+
+static uint16_t rd16(const uint8_t *p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t rd32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Percorre os blocos do RIFF procurando "fmt " e "data"
+static int parse_wav(input_t *in, const uint8_t *buf, size_t len) {
+  const uint8_t *fmt = NULL;
+  size_t pos = 12;
+
+  while (pos + 8 <= len) {
+    const uint8_t *chunk = buf + pos;
+    uint32_t size = rd32(chunk + 4);
+    size_t avail = len - pos - 8;
+
+    if (size > avail)
+      size = (uint32_t)avail; // gravação truncada: usa o que existe
+
+    if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+      fmt = chunk + 8;
+    } else if (memcmp(chunk, "data", 4) == 0) {
+      if (fmt == NULL)
+        break;
+
+      uint16_t tag = rd16(fmt);
+      uint16_t bits = rd16(fmt + 14);
+      in->channels = rd16(fmt + 2);
+      in->rate = rd32(fmt + 4);
+
+      if (tag != 1 || in->channels == 0 || (bits != 8 && bits != 16)) {
+        fprintf(stderr, "%s: apenas WAV PCM de 8 ou 16 bits é suportado\n", in->path);
+        return -1;
+      }
+
+      in->format = (bits == 8) ? INPUT_WAV_PCM8 : INPUT_WAV_PCM16;
+      in->data = chunk + 8;
+      in->frames = size / ((size_t)in->channels * (bits / 8));
+      return 0;
+    }
+
+    pos += 8 + size + (size & 1);
+  }
+
+  fprintf(stderr, "%s: WAV sem blocos fmt/data\n", in->path);
+  return -1;
+}
+
+int input_open(input_t *in, const char *path, uint32_t raw_rate) {
+  struct stat st;
+  int fd = open(path, O_RDONLY);
+
+  memset(in, 0, sizeof(*in));
+  in->path = path;
+
+  if (fd < 0 || fstat(fd, &st) < 0) {
+    perror(path);
+    if (fd >= 0)
+      close(fd);
+    return -1;
+  }
+
+  in->map_len = (size_t)st.st_size;
+  if (in->map_len > 0) {
+    in->map = mmap(NULL, in->map_len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (in->map == MAP_FAILED) {
+      perror(path);
+      close(fd);
+      in->map = NULL;
+      return -1;
+    }
+    madvise(in->map, in->map_len, MADV_SEQUENTIAL);
+  }
+  close(fd);
+
+  const uint8_t *buf = in->map;
+  if (in->map_len >= 12 && memcmp(buf, "RIFF", 4) == 0 && memcmp(buf + 8, "WAVE", 4) == 0) {
+    if (parse_wav(in, buf, in->map_len) < 0) {
+      input_close(in);
+      return -1;
+    }
+    return 0;
+  }
+
+  if (raw_rate == 0) {
+    fprintf(stderr, "%s: arquivo bruto do ADC requer --rate\n", path);
+    input_close(in);
+    return -1;
+  }
+
+  in->format = INPUT_RAW_ADC;
+  in->rate = raw_rate;
+  in->channels = 1;
+  in->data = buf;
+  in->frames = in->map_len / 2;
+  return 0;
+}
+
+void input_close(input_t *in) {
+  if (in->map != NULL)
+    munmap(in->map, in->map_len);
+  in->map = NULL;
+  in->data = NULL;
+}
+
+void input_read_adc(const input_t *in, size_t first, size_t count, uint16_t *out) {
+  size_t stride;
+
+  switch (in->format) {
+  case INPUT_RAW_ADC: {
+    const uint8_t *p = in->data + first * 2;
+    for (size_t i = 0; i < count; ++i, p += 2)
+      out[i] = rd16(p) & 0x0FFF;
+    break;
+  }
+  case INPUT_WAV_PCM8: {
+    // 8 bits sem sinal -> 12 bits
+    stride = in->channels;
+    const uint8_t *p = in->data + first * stride;
+    for (size_t i = 0; i < count; ++i, p += stride)
+      out[i] = (uint16_t)(*p << 4);
+    break;
+  }
+  case INPUT_WAV_PCM16: {
+    // 16 bits com sinal -> 12 bits sem sinal, com o zero no meio da escala como no MAX4466
+    stride = (size_t)in->channels * 2;
+    const uint8_t *p = in->data + first * stride;
+    for (size_t i = 0; i < count; ++i, p += stride)
+      out[i] = (uint16_t)(((int16_t)rd16(p) + 32768) >> 4);
+    break;
+  }
+  }
+}
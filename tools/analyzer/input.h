@@ -0,0 +1,34 @@
+#ifndef __ANALYZER_INPUT_INC
+#define __ANALYZER_INPUT_INC
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Formatos de gravação aceitos
+typedef enum {
+  INPUT_RAW_ADC,  // amostras do ADC (uint16 little-endian, 12 bits úteis)
+  INPUT_WAV_PCM8, // WAV PCM 8 bits sem sinal
+  INPUT_WAV_PCM16 // WAV PCM 16 bits com sinal
+} input_format_t;
+
+// Arquivo de entrada mapeado em memória
+typedef struct {
+  const char *path;
+  input_format_t format;
+  uint32_t rate;       // taxa de amostragem (Hz)
+  uint16_t channels;   // apenas o primeiro canal é analisado
+  const uint8_t *data; // início das amostras
+  size_t frames;       // quantidade de amostras por canal
+  void *map;
+  size_t map_len;
+} input_t;
+
+// Abre e mapeia o arquivo. raw_rate é usado para arquivos sem cabeçalho.
+// Retorna 0 em caso de sucesso ou -1 (mensagem impressa em stderr).
+int input_open(input_t *in, const char *path, uint32_t raw_rate);
+void input_close(input_t *in);
+
+// Converte count amostras a partir de first para códigos do ADC de 12 bits
+void input_read_adc(const input_t *in, size_t first, size_t count, uint16_t *out);
+
+#endif
@@ -0,0 +1,168 @@
+#include "kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KERNELS_X86 1
+#endif
+
+// Quantidade máxima de iterações antes de esvaziar os contadores de 16 bits
+#define KERNEL_FLUSH_ITERS 16384
+
+// Aplica o resultado parcial na janela, igual à sequência de level_window_push()
+static void kernel_apply(level_window_t *w, uint16_t max, uint16_t min, size_t valid, size_t clip_high,
+                         size_t clip_low, uint64_t sum) {
+  level_window_t part = {
+    .signal_max = max, .signal_min = min, .count = (uint32_t)valid,
+    .clip_high = (uint32_t)clip_high, .clip_low = (uint32_t)clip_low, .sum = sum
+  };
+  level_window_merge(w, &part);
+}
+
+#ifdef KERNELS_X86
+
+// As amostras têm 12 bits, então as comparações com sinal de 16 bits bastam.
+// Amostras saturadas (nos trilhos do ADC) viram 0 para o máximo e para a soma e
+// 0x7FFF para o mínimo. Os contadores por faixa são de 16 bits (saturação) e de
+// 32 bits (soma de pares com madd) e são esvaziados a cada KERNEL_FLUSH_ITERS.
+
+__attribute__((target("sse2")))
+static void kernel_sse2(level_window_t *w, const uint16_t *samples, size_t n) {
+  const __m128i limit = _mm_set1_epi16(LEVEL_ADC_MAX - 1);
+  const __m128i floor = _mm_set1_epi16(LEVEL_ADC_MIN + 1);
+  const __m128i high = _mm_set1_epi16(0x7FFF);
+  const __m128i ones = _mm_set1_epi16(1);
+  __m128i vmax = _mm_setzero_si128();
+  __m128i vmin = high;
+  size_t clip_high = 0, clip_low = 0;
+  uint64_t sum = 0;
+  size_t i = 0;
+
+  while (i + 8 <= n) {
+    __m128i vhigh = _mm_setzero_si128();
+    __m128i vlow = _mm_setzero_si128();
+    __m128i vsum = _mm_setzero_si128();
+    size_t iters = 0;
+
+    for (; i + 8 <= n && iters < KERNEL_FLUSH_ITERS; i += 8, ++iters) {
+      __m128i x = _mm_loadu_si128((const __m128i *)(samples + i));
+      __m128i mh = _mm_cmpgt_epi16(x, limit);
+      __m128i ml = _mm_cmplt_epi16(x, floor);
+      __m128i m = _mm_or_si128(mh, ml);
+      __m128i v = _mm_andnot_si128(m, x);
+      vmax = _mm_max_epi16(vmax, v);
+      vmin = _mm_min_epi16(vmin, _mm_or_si128(x, _mm_and_si128(m, high)));
+      vsum = _mm_add_epi32(vsum, _mm_madd_epi16(v, ones));
+      vhigh = _mm_sub_epi16(vhigh, mh);
+      vlow = _mm_sub_epi16(vlow, ml);
+    }
+
+    uint16_t lhigh[8], llow[8];
+    uint32_t lsum[4];
+    _mm_storeu_si128((__m128i *)lhigh, vhigh);
+    _mm_storeu_si128((__m128i *)llow, vlow);
+    _mm_storeu_si128((__m128i *)lsum, vsum);
+    for (int k = 0; k < 8; ++k) {
+      clip_high += lhigh[k];
+      clip_low += llow[k];
+    }
+    for (int k = 0; k < 4; ++k)
+      sum += lsum[k];
+  }
+
+  uint16_t lmax[8], lmin[8];
+  _mm_storeu_si128((__m128i *)lmax, vmax);
+  _mm_storeu_si128((__m128i *)lmin, vmin);
+
+  uint16_t max = 0, min = LEVEL_ADC_MAX;
+  for (int k = 0; k < 8; ++k) {
+    if (lmax[k] > max)
+      max = lmax[k];
+    if (lmin[k] < min)
+      min = lmin[k];
+  }
+
+  kernel_apply(w, max, min, i - clip_high - clip_low, clip_high, clip_low, sum);
+  level_window_push_block(w, samples + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void kernel_avx2(level_window_t *w, const uint16_t *samples, size_t n) {
+  const __m256i limit = _mm256_set1_epi16(LEVEL_ADC_MAX - 1);
+  const __m256i floor = _mm256_set1_epi16(LEVEL_ADC_MIN + 1);
+  const __m256i high = _mm256_set1_epi16(0x7FFF);
+  const __m256i ones = _mm256_set1_epi16(1);
+  __m256i vmax = _mm256_setzero_si256();
+  __m256i vmin = high;
+  size_t clip_high = 0, clip_low = 0;
+  uint64_t sum = 0;
+  size_t i = 0;
+
+  while (i + 16 <= n) {
+    __m256i vhigh = _mm256_setzero_si256();
+    __m256i vlow = _mm256_setzero_si256();
+    __m256i vsum = _mm256_setzero_si256();
+    size_t iters = 0;
+
+    for (; i + 16 <= n && iters < KERNEL_FLUSH_ITERS; i += 16, ++iters) {
+      __m256i x = _mm256_loadu_si256((const __m256i *)(samples + i));
+      __m256i mh = _mm256_cmpgt_epi16(x, limit);
+      __m256i ml = _mm256_cmpgt_epi16(floor, x);
+      __m256i m = _mm256_or_si256(mh, ml);
+      __m256i v = _mm256_andnot_si256(m, x);
+      vmax = _mm256_max_epi16(vmax, v);
+      vmin = _mm256_min_epi16(vmin, _mm256_or_si256(x, _mm256_and_si256(m, high)));
+      vsum = _mm256_add_epi32(vsum, _mm256_madd_epi16(v, ones));
+      vhigh = _mm256_sub_epi16(vhigh, mh);
+      vlow = _mm256_sub_epi16(vlow, ml);
+    }
+
+    uint16_t lhigh[16], llow[16];
+    uint32_t lsum[8];
+    _mm256_storeu_si256((__m256i *)lhigh, vhigh);
+    _mm256_storeu_si256((__m256i *)llow, vlow);
+    _mm256_storeu_si256((__m256i *)lsum, vsum);
+    for (int k = 0; k < 16; ++k) {
+      clip_high += lhigh[k];
+      clip_low += llow[k];
+    }
+    for (int k = 0; k < 8; ++k)
+      sum += lsum[k];
+  }
+
+  uint16_t lmax[16], lmin[16];
+  _mm256_storeu_si256((__m256i *)lmax, vmax);
+  _mm256_storeu_si256((__m256i *)lmin, vmin);
+
+  uint16_t max = 0, min = LEVEL_ADC_MAX;
+  for (int k = 0; k < 16; ++k) {
+    if (lmax[k] > max)
+      max = lmax[k];
+    if (lmin[k] < min)
+      min = lmin[k];
+  }
+
+  kernel_apply(w, max, min, i - clip_high - clip_low, clip_high, clip_low, sum);
+  level_window_push_block(w, samples + i, n - i);
+}
+
+#endif
+
+kernel_t kernel_select(int force_scalar) {
+  kernel_t k = { "scalar", level_window_push_block };
+
+  if (force_scalar)
+    return k;
+
+#ifdef KERNELS_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    k.name = "avx2";
+    k.fn = kernel_avx2;
+  } else if (__builtin_cpu_supports("sse2")) {
+    k.name = "sse2";
+    k.fn = kernel_sse2;
+  }
+#endif
+
+  return k;
+}
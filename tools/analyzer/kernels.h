@@ -0,0 +1,18 @@
+#ifndef __ANALYZER_KERNELS_INC
+#define __ANALYZER_KERNELS_INC
+
+#include "inc/audio/level.h"
+
+// Acumula um bloco de amostras de 12 bits na janela. Todas as variantes produzem
+// exatamente o mesmo resultado que level_window_push_block().
+typedef void (*kernel_fn_t)(level_window_t *w, const uint16_t *samples, size_t n);
+
+typedef struct {
+  const char *name;
+  kernel_fn_t fn;
+} kernel_t;
+
+// Escolhe a melhor variante suportada pela CPU (ou a escalar se force_scalar)
+kernel_t kernel_select(int force_scalar);
+
+#endif
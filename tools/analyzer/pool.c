@@ -0,0 +1,90 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pool.h"
+
+typedef struct {
+  atomic_size_t next;
+  size_t task_count;
+  pool_task_fn_t fn;
+  void *ctx;
+} pool_queue_t;
+
+typedef struct {
+  pool_queue_t *queue;
+  unsigned index;
+  pool_worker_stats_t stats;
+} pool_worker_t;
+
+uint64_t pool_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void *pool_worker_main(void *arg) {
+  pool_worker_t *w = arg;
+  pool_queue_t *q = w->queue;
+
+  for (;;) {
+    size_t task = atomic_fetch_add_explicit(&q->next, 1, memory_order_relaxed);
+    if (task >= q->task_count)
+      break;
+
+    uint64_t start = pool_now_ns();
+    q->fn(q->ctx, task, w->index);
+    w->stats.busy_ns += pool_now_ns() - start;
+    w->stats.tasks++;
+  }
+
+  return NULL;
+}
+
+int pool_run(unsigned workers, size_t task_count, pool_task_fn_t fn, void *ctx, pool_worker_stats_t *stats) {
+  pool_queue_t queue = { .task_count = task_count, .fn = fn, .ctx = ctx };
+  pool_worker_t *pool;
+  pthread_t *threads;
+  unsigned started = 0;
+
+  if (workers == 0)
+    workers = 1;
+
+  atomic_init(&queue.next, 0);
+  pool = calloc(workers, sizeof(*pool));
+  threads = calloc(workers, sizeof(*threads));
+  if (pool == NULL || threads == NULL) {
+    free(pool);
+    free(threads);
+    return -1;
+  }
+
+  for (unsigned i = 0; i < workers; ++i) {
+    pool[i].queue = &queue;
+    pool[i].index = i;
+  }
+
+  // O worker 0 roda na thread chamadora. Se não for possível criar uma thread,
+  // as tarefas restantes ficam com os workers que já estão rodando.
+  for (unsigned i = 1; i < workers; ++i) {
+    if (pthread_create(&threads[i], NULL, pool_worker_main, &pool[i]) != 0)
+      break;
+    started = i;
+  }
+
+  pool_worker_main(&pool[0]);
+
+  for (unsigned i = 1; i <= started; ++i)
+    pthread_join(threads[i], NULL);
+
+  if (stats != NULL) {
+    for (unsigned i = 0; i < workers; ++i)
+      stats[i] = pool[i].stats;
+  }
+
+  free(pool);
+  free(threads);
+  return 0;
+}
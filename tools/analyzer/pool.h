@@ -0,0 +1,23 @@
+#ifndef __ANALYZER_POOL_INC
+#define __ANALYZER_POOL_INC
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Executa task_count tarefas independentes em threads workers.
+// Cada worker pega a próxima tarefa livre até a fila acabar.
+typedef void (*pool_task_fn_t)(void *ctx, size_t task, unsigned worker);
+
+// Estatísticas de um worker
+typedef struct {
+  uint64_t busy_ns; // tempo gasto executando tarefas
+  size_t tasks;
+} pool_worker_stats_t;
+
+// Retorna 0 em caso de sucesso. stats deve ter espaço para workers itens (ou ser NULL).
+int pool_run(unsigned workers, size_t task_count, pool_task_fn_t fn, void *ctx, pool_worker_stats_t *stats);
+
+// Tempo monotônico em nanossegundos
+uint64_t pool_now_ns(void);
+
+#endif
@@ -0,0 +1,196 @@
+// Visualizador do espelhamento do display (firmware compilado com DECIMETER_MIRROR).
+//
+// Lê o log da serial (arquivo, dispositivo ou stdin), reconstrói os quadros a
+// partir das linhas "@FB" e os exibe no terminal e/ou grava como imagens PBM.
+// Ao final, informa a banda usada por quadro em cada tela da GUI.
+
+#include <getopt.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "inc/display/mirror.h"
+
+// Telas da GUI (PAGE_* em src/main.c)
+#define SCREEN_COUNT 4
+static const char *const screen_names[SCREEN_COUNT] = {
+  "MENU", "VISUALIZACAO", "DEF NIVEL", "CONFIGURACAO"
+};
+
+typedef struct {
+  unsigned long frames, keyframes;
+  unsigned long long encoded_bytes; // RLE
+  unsigned long long line_bytes;    // linha completa enviada pela serial
+} screen_stats_t;
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig) {
+  (void)sig;
+  stop = 1;
+}
+
+static int pixel(const uint8_t *fb, unsigned width, unsigned x, unsigned y) {
+  return (fb[(y >> 3) * width + x] >> (y & 7)) & 1;
+}
+
+// Desenha o quadro com meio-blocos: cada caractere representa dois pixels verticais
+static void draw_ascii(const uint8_t *fb, unsigned width, unsigned height, unsigned seq, unsigned screen) {
+  printf("\x1b[H\x1b[2J@FB %u  tela %s\n", seq, screen < SCREEN_COUNT ? screen_names[screen] : "?");
+  for (unsigned y = 0; y < height; y += 2) {
+    for (unsigned x = 0; x < width; ++x) {
+      int top = pixel(fb, width, x, y);
+      int bottom = y + 1 < height && pixel(fb, width, x, y + 1);
+      fputs(top && bottom ? "█" : top ? "▀" : bottom ? "▄" : " ", stdout);
+    }
+    fputc('\n', stdout);
+  }
+  fflush(stdout);
+}
+
+static int write_pbm(const char *dir, unsigned seq, const uint8_t *fb, unsigned width, unsigned height) {
+  char path[4096];
+  snprintf(path, sizeof(path), "%s/frame_%06u.pbm", dir, seq);
+
+  FILE *f = fopen(path, "wb");
+  if (f == NULL) {
+    perror(path);
+    return -1;
+  }
+
+  fprintf(f, "P4\n%u %u\n", width, height);
+  for (unsigned y = 0; y < height; ++y) {
+    for (unsigned x = 0; x < width; x += 8) {
+      uint8_t byte = 0;
+      for (unsigned b = 0; b < 8 && x + b < width; ++b)
+        byte |= (uint8_t)(pixel(fb, width, x + b, y) << (7 - b));
+      fputc(byte, f);
+    }
+  }
+
+  fclose(f);
+  return 0;
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "uso: %s [opções] [log|dispositivo]\n"
+          "  -a, --ascii        exibe os quadros no terminal\n"
+          "  -r, --record DIR   grava cada quadro como DIR/frame_NNNNNN.pbm\n"
+          "Sem arquivo, lê de stdin. Ex.: %s -a /dev/ttyACM0\n",
+          prog, prog);
+}
+
+int main(int argc, char **argv) {
+  static const struct option options[] = {
+    { "ascii", no_argument, NULL, 'a' },
+    { "record", required_argument, NULL, 'r' },
+    { "help", no_argument, NULL, 'h' },
+    { NULL, 0, NULL, 0 }
+  };
+  const char *record_dir = NULL;
+  int ascii = 0, opt;
+
+  while ((opt = getopt_long(argc, argv, "ar:h", options, NULL)) != -1) {
+    switch (opt) {
+    case 'a': ascii = 1; break;
+    case 'r': record_dir = optarg; break;
+    default:
+      usage(argv[0]);
+      return opt == 'h' ? 0 : 2;
+    }
+  }
+
+  FILE *in = stdin;
+  if (optind < argc && (in = fopen(argv[optind], "r")) == NULL) {
+    perror(argv[optind]);
+    return 1;
+  }
+
+  signal(SIGINT, on_signal);
+
+  static uint8_t frame[MIRROR_MAX_FRAME];
+  static uint8_t encoded[MIRROR_MAX_ENCODED];
+  screen_stats_t stats[SCREEN_COUNT] = { 0 };
+  unsigned long invalid = 0, lost = 0;
+  unsigned last_seq = 0;
+  int synced = 0, have_seq = 0;
+  char *line = NULL;
+  size_t cap = 0;
+  ssize_t len;
+
+  while (!stop && (len = getline(&line, &cap, in)) >= 0) {
+    char *p = strstr(line, "@FB ");
+    unsigned seq, screen, width, height;
+    char kind;
+    int head;
+
+    if (p == NULL)
+      continue;
+    if (sscanf(p, "@FB %u %u %c %u %u %n", &seq, &screen, &kind, &width, &height, &head) != 5 ||
+        (size_t)width * (height / 8) > MIRROR_MAX_FRAME) {
+      invalid++;
+      continue;
+    }
+
+    // Quadros perdidos: os deltas seguintes só valem após o próximo quadro chave
+    if (have_seq && (uint16_t)(seq - last_seq) != 1) {
+      lost += (uint16_t)(seq - last_seq - 1);
+      synced = 0;
+    }
+    last_seq = seq;
+    have_seq = 1;
+
+    char *b64 = p + head;
+    size_t b64_len = strcspn(b64, "\r\n");
+    long enc_len = mirror_base64_decode(b64, b64_len, encoded, sizeof(encoded));
+    size_t frame_len = (size_t)width * (height / 8);
+
+    if (enc_len < 0) {
+      invalid++;
+      synced = 0;
+      continue;
+    }
+
+    if (kind == 'k') {
+      memset(frame, 0, frame_len);
+      synced = 1;
+    }
+    if (mirror_rle_apply(encoded, (size_t)enc_len, frame, frame_len) < 0) {
+      invalid++;
+      synced = 0;
+      continue;
+    }
+
+    if (screen < SCREEN_COUNT) {
+      stats[screen].frames++;
+      stats[screen].keyframes += kind == 'k';
+      stats[screen].encoded_bytes += (unsigned long long)enc_len;
+      stats[screen].line_bytes += (unsigned long long)(strlen(p));
+    }
+
+    if (!synced)
+      continue;
+
+    if (ascii)
+      draw_ascii(frame, width, height, seq, screen);
+    if (record_dir != NULL && write_pbm(record_dir, seq, frame, width, height) < 0)
+      return 1;
+  }
+
+  // Banda por tela (quadros sem mudança não são enviados e não entram na conta)
+  fprintf(stderr, "%-14s %8s %8s %12s %12s\n", "tela", "quadros", "chave", "RLE/quadro", "linha/quadro");
+  for (int i = 0; i < SCREEN_COUNT; ++i) {
+    double n = stats[i].frames ? (double)stats[i].frames : 1.0;
+    fprintf(stderr, "%-14s %8lu %8lu %10.1f B %10.1f B\n", screen_names[i], stats[i].frames, stats[i].keyframes,
+            stats[i].encoded_bytes / n, stats[i].line_bytes / n);
+  }
+  fprintf(stderr, "quadros perdidos: %lu, linhas inválidas: %lu (quadro bruto: %d B)\n", lost, invalid,
+          MIRROR_MAX_FRAME);
+
+  free(line);
+  if (in != stdin)
+    fclose(in);
+  return 0;
+}
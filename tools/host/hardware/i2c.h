@@ -0,0 +1,21 @@
+#ifndef __HOST_HARDWARE_I2C_INC
+#define __HOST_HARDWARE_I2C_INC
+
+#include "pico/stdlib.h"
+
+typedef struct i2c_inst i2c_inst_t;
+
+extern i2c_inst_t *const i2c0;
+extern i2c_inst_t *const i2c1;
+
+// Captura dos dados enviados pelo barramento (NULL descarta)
+typedef void (*host_i2c_capture_t)(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len);
+extern host_i2c_capture_t host_i2c_capture;
+
+// Total de bytes enviados desde o início do programa
+extern uint64_t host_i2c_bytes;
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+#endif
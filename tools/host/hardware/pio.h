@@ -0,0 +1,45 @@
+#ifndef __HOST_HARDWARE_PIO_INC
+#define __HOST_HARDWARE_PIO_INC
+
+// Substituto do PIO: guarda o espaço de instruções ocupado e as máquinas de estado
+// em uso em cada bloco. As palavras colocadas na FIFO de transmissão vão para
+// host_pio_capture.
+
+#include "pico/stdlib.h"
+
+#define NUM_PIOS 2
+#define NUM_PIO_STATE_MACHINES 4
+#define PIO_INSTRUCTION_COUNT 32
+
+typedef struct pio_inst *PIO;
+
+extern PIO const pio0;
+extern PIO const pio1;
+
+typedef struct {
+  const uint16_t *instructions;
+  uint8_t length;
+  int8_t origin;
+} pio_program_t;
+
+// Captura das palavras enviadas às máquinas (NULL descarta)
+typedef void (*host_pio_capture_t)(PIO pio, uint sm, uint32_t data);
+extern host_pio_capture_t host_pio_capture;
+
+// Programas carregados em cada bloco desde o início do programa
+extern uint host_pio_programs[NUM_PIOS];
+
+uint pio_get_index(PIO pio);
+bool pio_can_add_program(PIO pio, const pio_program_t *program);
+uint pio_add_program(PIO pio, const pio_program_t *program);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+
+// As palavras são entregues na hora: a FIFO está sempre vazia
+static inline bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm) {
+  (void)pio;
+  (void)sm;
+  return true;
+}
+
+#endif
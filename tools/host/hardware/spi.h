@@ -0,0 +1,28 @@
+#ifndef __HOST_HARDWARE_SPI_INC
+#define __HOST_HARDWARE_SPI_INC
+
+#include "pico/stdlib.h"
+
+typedef struct {
+  volatile uint32_t dr; // registrador de dados (destino das transferências por DMA)
+} spi_hw_t;
+
+typedef struct spi_inst spi_inst_t;
+
+extern spi_inst_t *const spi0;
+extern spi_inst_t *const spi1;
+
+// Captura dos bytes enviados pelo barramento, seja por spi_write_blocking ou
+// por DMA para o registrador de dados (NULL descarta)
+typedef void (*host_spi_capture_t)(spi_inst_t *spi, const uint8_t *src, size_t len);
+extern host_spi_capture_t host_spi_capture;
+
+uint spi_init(spi_inst_t *spi, uint baudrate);
+int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len);
+spi_hw_t *spi_get_hw(spi_inst_t *spi);
+uint spi_get_dreq(spi_inst_t *spi, bool is_tx);
+
+// No host a transmissão termina dentro de spi_write_blocking
+static inline bool spi_is_busy(const spi_inst_t *spi) { (void)spi; return false; }
+
+#endif
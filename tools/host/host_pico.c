@@ -0,0 +1,167 @@
+#include "hardware/dma.h"
+#include "hardware/i2c.h"
+#include "hardware/pio.h"
+#include "hardware/spi.h"
+
+uint32_t host_gpio_state;
+uint64_t host_sleep_us;
+
+// I2C
+
+struct i2c_inst {
+  int index;
+};
+
+static struct i2c_inst host_i2c[2] = { { 0 }, { 1 } };
+
+i2c_inst_t *const i2c0 = &host_i2c[0];
+i2c_inst_t *const i2c1 = &host_i2c[1];
+
+host_i2c_capture_t host_i2c_capture;
+uint64_t host_i2c_bytes;
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+  (void)i2c;
+  return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+  (void)nostop;
+  host_i2c_bytes += len;
+  if (host_i2c_capture != NULL)
+    host_i2c_capture(i2c, addr, src, len);
+  return (int)len;
+}
+
+// SPI
+
+struct spi_inst {
+  spi_hw_t hw;
+};
+
+static struct spi_inst host_spi[2];
+
+spi_inst_t *const spi0 = &host_spi[0];
+spi_inst_t *const spi1 = &host_spi[1];
+
+host_spi_capture_t host_spi_capture;
+
+uint spi_init(spi_inst_t *spi, uint baudrate) {
+  (void)spi;
+  return baudrate;
+}
+
+int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len) {
+  if (host_spi_capture != NULL)
+    host_spi_capture(spi, src, len);
+  return (int)len;
+}
+
+spi_hw_t *spi_get_hw(spi_inst_t *spi) {
+  return &spi->hw;
+}
+
+uint spi_get_dreq(spi_inst_t *spi, bool is_tx) {
+  return (uint)(spi - host_spi) * 2 + (is_tx ? 0 : 1);
+}
+
+// DMA
+
+static uint32_t host_dma_claimed;
+
+int dma_claim_unused_channel(bool required) {
+  (void)required;
+  for (uint channel = 0; channel < HOST_DMA_CHANNELS; ++channel) {
+    if (!(host_dma_claimed & (1u << channel))) {
+      host_dma_claimed |= 1u << channel;
+      return (int)channel;
+    }
+  }
+  return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+  host_dma_claimed &= ~(1u << channel);
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+  (void)channel;
+  dma_channel_config c = { .size = DMA_SIZE_32, .read_increment = true, .write_increment = false, .dreq = 0 };
+  return c;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+  (void)channel;
+  if (!trigger || transfer_count == 0)
+    return;
+
+  // Bytes lidos em sequência e escritos no registrador de dados de um SPI
+  for (size_t i = 0; i < sizeof(host_spi) / sizeof(host_spi[0]); ++i) {
+    if (write_addr == &host_spi[i].hw.dr && config->size == DMA_SIZE_8 && config->read_increment) {
+      spi_write_blocking(&host_spi[i], (const uint8_t *)read_addr, transfer_count);
+      return;
+    }
+  }
+
+  // Demais destinos: cópia em memória
+  size_t size = (size_t)1 << config->size;
+  const volatile uint8_t *src = read_addr;
+  volatile uint8_t *dst = write_addr;
+  for (uint i = 0; i < transfer_count; ++i) {
+    for (size_t b = 0; b < size; ++b)
+      dst[b] = src[b];
+    if (config->read_increment)
+      src += size;
+    if (config->write_increment)
+      dst += size;
+  }
+}
+
+// PIO
+
+struct pio_inst {
+  uint index;
+  uint used;        // instruções ocupadas
+  uint32_t claimed; // máquinas em uso, um bit por máquina
+};
+
+static struct pio_inst host_pio[NUM_PIOS] = { { .index = 0 }, { .index = 1 } };
+
+PIO const pio0 = &host_pio[0];
+PIO const pio1 = &host_pio[1];
+
+host_pio_capture_t host_pio_capture;
+uint host_pio_programs[NUM_PIOS];
+
+uint pio_get_index(PIO pio) {
+  return pio->index;
+}
+
+bool pio_can_add_program(PIO pio, const pio_program_t *program) {
+  return pio->used + program->length <= PIO_INSTRUCTION_COUNT;
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+  uint offset = pio->used;
+
+  pio->used += program->length;
+  host_pio_programs[pio->index]++;
+  return offset;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+  (void)required;
+  for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; ++sm) {
+    if (!(pio->claimed & (1u << sm))) {
+      pio->claimed |= 1u << sm;
+      return (int)sm;
+    }
+  }
+  return -1;
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+  if (host_pio_capture != NULL)
+    host_pio_capture(pio, sm, data);
+}
@@ -0,0 +1,38 @@
+#ifndef __HOST_PICO_STDLIB_INC
+#define __HOST_PICO_STDLIB_INC
+
+// Substituto mínimo do SDK do Pico para compilar os módulos do firmware no host.
+// Apenas o que os módulos compartilhados com as ferramentas utilizam.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+
+// GPIO: apenas o nível das saídas é guardado (host_gpio_state, um bit por pino)
+enum gpio_function { GPIO_FUNC_SPI = 1, GPIO_FUNC_I2C = 3, GPIO_FUNC_SIO = 5 };
+
+#define GPIO_OUT 1
+#define GPIO_IN 0
+
+extern uint32_t host_gpio_state;
+
+static inline void gpio_set_function(uint gpio, enum gpio_function fn) { (void)gpio; (void)fn; }
+static inline void gpio_pull_up(uint gpio) { (void)gpio; }
+static inline void gpio_init(uint gpio) { host_gpio_state &= ~(1u << gpio); }
+static inline void gpio_set_dir(uint gpio, bool out) { (void)gpio; (void)out; }
+static inline void gpio_put(uint gpio, bool value) {
+  if (value)
+    host_gpio_state |= 1u << gpio;
+  else
+    host_gpio_state &= ~(1u << gpio);
+}
+static inline bool gpio_get(uint gpio) { return (host_gpio_state >> gpio) & 1u; }
+
+static inline void tight_loop_contents(void) {}
+// Esperas não param o programa: apenas somam o tempo pedido
+extern uint64_t host_sleep_us;
+static inline void sleep_us(uint64_t us) { host_sleep_us += us; }
+
+#endif
@@ -0,0 +1,468 @@
+// Replay determinístico das janelas de medição gravadas pelo firmware.
+//
+// Lê a gravação feita com DECIMETER_RECORD (linhas "@R ..." da serial; as demais
+// linhas são ignoradas) e passa cada janela pelo mesmo código do firmware:
+// cálculo de nível, decisão do alarme e desenho da página de visualização.
+// O tempo vem das marcas da gravação (relógio virtual), então o resultado não
+// depende da velocidade do computador.
+//
+// O governador de atualização também roda sobre o relógio virtual e, ao final,
+// sua permanência em cada estado é informada, assim como a banda que o
+// espelhamento do display (inc/display/mirror.h) usaria por quadro.
+//
+// Com --write-golden o resultado é salvo como referência. Com --golden ele é
+// comparado com uma referência salva, dentro das tolerâncias informadas. A
+// referência começa com GOLDEN_HEADER; arquivos sem ele ou de outra versão do
+// formato são recusados.
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "inc/audio/level.h"
+#include "inc/display/display.h"
+#include "inc/display/mirror.h"
+#include "inc/power/governor.h"
+
+#define GOLDEN_HEADER "# decimeter-golden v3"
+#define MAX_REPORTED_MISMATCHES 20
+
+SSD1306_DEFINE(ssd, WIDTH, HEIGHT);
+
+// Janela gravada
+typedef struct {
+  uint64_t start_us;
+  uint32_t end_us; // relativo ao início
+  unsigned int db_boundary;
+  bool led_enabled;
+  uint32_t dropped;
+  uint16_t *samples;
+  size_t count, capacity;
+} rec_window_t;
+
+// Resultado de uma janela
+typedef struct {
+  size_t index;
+  uint64_t t_ms; // relógio virtual, relativo à primeira janela
+  uint32_t samples;
+  uint16_t peak_to_peak;
+  unsigned int db;
+  unsigned int flags; // LEVEL_FLAG_*
+  level_alarm_level_t alarm;
+} result_t;
+
+typedef struct {
+  FILE *file;
+  uint8_t framebuffer[SSD1306_BUFSIZE(WIDTH, HEIGHT)];
+  char *line;
+  size_t line_cap;
+} golden_t;
+
+typedef struct {
+  unsigned int db_tol;
+  unsigned int fb_tol;
+  size_t mismatches;
+  size_t transitions;
+} compare_t;
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void window_push(rec_window_t *w, uint16_t sample) {
+  if (w->count == w->capacity) {
+    w->capacity = w->capacity ? w->capacity * 2 : 4096;
+    w->samples = realloc(w->samples, w->capacity * sizeof(uint16_t));
+    if (w->samples == NULL) {
+      fprintf(stderr, "sem memória\n");
+      exit(1);
+    }
+  }
+  w->samples[w->count++] = sample;
+}
+
+static void write_framebuffer(FILE *out, const uint8_t *fb, size_t len) {
+  fputc('f', out);
+  fputc(' ', out);
+  for (size_t i = 0; i < len; ++i)
+    fprintf(out, "%02x", fb[i]);
+  fputc('\n', out);
+}
+
+static int parse_framebuffer(const char *hex, uint8_t *fb, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    unsigned int byte;
+    if (sscanf(hex + 2 * i, "%2x", &byte) != 1)
+      return -1;
+    fb[i] = (uint8_t)byte;
+  }
+  return 0;
+}
+
+static unsigned int pixel_diff(const uint8_t *a, const uint8_t *b, size_t len) {
+  unsigned int diff = 0;
+  // O primeiro byte é o prefixo de dados do I2C
+  for (size_t i = 1; i < len; ++i)
+    diff += (unsigned int)__builtin_popcount(a[i] ^ b[i]);
+  return diff;
+}
+
+// Lê o próximo registro "g" da referência (e o "f" seguinte, se houver)
+static int golden_next(golden_t *g, result_t *r) {
+  int have = 0;
+
+  for (;;) {
+    long pos = ftell(g->file);
+    if (getline(&g->line, &g->line_cap, g->file) < 0)
+      return have ? 0 : -1;
+
+    if (g->line[0] == 'g') {
+      if (have) {
+        fseek(g->file, pos, SEEK_SET);
+        return 0;
+      }
+      unsigned int p2p, alarm;
+      if (sscanf(g->line, "g %zu %" SCNu64 " %" SCNu32 " %u %u %u %u", &r->index, &r->t_ms, &r->samples,
+                 &p2p, &r->db, &alarm, &r->flags) != 7)
+        return -1;
+      if (alarm > LEVEL_ALARM_CRITICAL)
+        return -1;
+      r->peak_to_peak = (uint16_t)p2p;
+      r->alarm = (level_alarm_level_t)alarm;
+      have = 1;
+    } else if (g->line[0] == 'f' && have) {
+      if (parse_framebuffer(g->line + 2, g->framebuffer, sizeof(g->framebuffer)) < 0)
+        return -1;
+      return 0;
+    }
+  }
+}
+
+// Confere a primeira linha da referência
+static int golden_check_header(golden_t *g) {
+  if (getline(&g->line, &g->line_cap, g->file) < 0)
+    return -1;
+  g->line[strcspn(g->line, "\r\n")] = '\0';
+  return strcmp(g->line, GOLDEN_HEADER) == 0 ? 0 : -1;
+}
+
+static const char *alarm_name(level_alarm_level_t alarm) {
+  switch (alarm) {
+  case LEVEL_ALARM_NONE: return "desligado";
+  case LEVEL_ALARM_ABOVE: return "acima do limite";
+  case LEVEL_ALARM_CRITICAL: return "crítico";
+  }
+  return "?";
+}
+
+static void report(compare_t *c, const result_t *r, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+
+static void report(compare_t *c, const result_t *r, const char *fmt, ...) {
+  if (++c->mismatches > MAX_REPORTED_MISMATCHES)
+    return;
+
+  va_list ap;
+  va_start(ap, fmt);
+  fprintf(stderr, "janela %zu (t=%" PRIu64 " ms): ", r->index, r->t_ms);
+  vfprintf(stderr, fmt, ap);
+  fputc('\n', stderr);
+  va_end(ap);
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "uso: %s [opções] gravacao.log\n"
+          "  -g, --golden ARQ        compara com a referência\n"
+          "  -w, --write-golden ARQ  salva o resultado como referência\n"
+          "  -d, --db-tol N          diferença máxima em dB (padrão 0)\n"
+          "  -p, --fb-tol N          pixels diferentes aceitos por quadro (padrão 0)\n",
+          prog);
+}
+
+int main(int argc, char **argv) {
+  static const struct option options[] = {
+    { "golden", required_argument, NULL, 'g' },
+    { "write-golden", required_argument, NULL, 'w' },
+    { "db-tol", required_argument, NULL, 'd' },
+    { "fb-tol", required_argument, NULL, 'p' },
+    { "help", no_argument, NULL, 'h' },
+    { NULL, 0, NULL, 0 }
+  };
+  const char *golden_path = NULL, *write_path = NULL;
+  compare_t cmp = { 0 };
+  golden_t golden = { 0 };
+  FILE *out = NULL;
+  int opt;
+
+  while ((opt = getopt_long(argc, argv, "g:w:d:p:h", options, NULL)) != -1) {
+    switch (opt) {
+    case 'g': golden_path = optarg; break;
+    case 'w': write_path = optarg; break;
+    case 'd': cmp.db_tol = (unsigned int)strtoul(optarg, NULL, 10); break;
+    case 'p': cmp.fb_tol = (unsigned int)strtoul(optarg, NULL, 10); break;
+    default:
+      usage(argv[0]);
+      return opt == 'h' ? 0 : 2;
+    }
+  }
+
+  if (optind + 1 != argc) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  FILE *in = fopen(argv[optind], "r");
+  if (in == NULL) {
+    perror(argv[optind]);
+    return 1;
+  }
+
+  if (golden_path != NULL) {
+    golden.file = fopen(golden_path, "r");
+    if (golden.file == NULL) {
+      perror(golden_path);
+      return 1;
+    }
+    if (golden_check_header(&golden) < 0) {
+      fprintf(stderr, "%s: referência sem o cabeçalho \"%s\" (formato antigo ou outro arquivo)\n", golden_path,
+              GOLDEN_HEADER);
+      return 1;
+    }
+  }
+
+  if (write_path != NULL) {
+    out = fopen(write_path, "w");
+    if (out == NULL) {
+      perror(write_path);
+      return 1;
+    }
+    fprintf(out, "%s\n", GOLDEN_HEADER);
+  }
+
+  // Desenha o layout fixo, como na inicialização do firmware
+  if (!display_setup(&ssd, 0x3C, i2c1)) {
+    fprintf(stderr, "falha ao inicializar o display\n");
+    return 1;
+  }
+  display_draw_main_layout(&ssd);
+
+  static uint8_t last_fb[SSD1306_BUFSIZE(WIDTH, HEIGHT)];
+  rec_window_t win = { 0 };
+  bool in_window = false, have_prev = false;
+  level_alarm_level_t prev_alarm = LEVEL_ALARM_NONE;
+  bool have_first = false;
+  uint64_t first_us = 0;
+  size_t windows = 0, total_samples = 0, dropped_windows = 0;
+  uint64_t measure_ns = 0, render_ns = 0;
+  governor_t governor;
+  size_t refreshes = 0;
+  static mirror_t mirror;
+  static char mirror_line[MIRROR_MAX_LINE];
+  size_t mirror_frames = 0, mirror_bytes = 0;
+  level_reading_t reading = { 0 };
+  level_noise_t noise;
+  size_t overload_windows = 0;
+
+  level_noise_reset(&noise);
+
+  // Um quadro espelhado por janela, com quadro chave a cada 25 (como no firmware)
+  mirror_init(&mirror, WIDTH, HEIGHT, 0, 25);
+  char *line = NULL;
+  size_t cap = 0;
+
+  while (getline(&line, &cap, in) >= 0) {
+    const char *p = strstr(line, "@R ");
+    if (p == NULL)
+      continue;
+    p += 3;
+
+    if (p[0] == 'w') {
+      unsigned long long start;
+      unsigned int boundary, led;
+      if (sscanf(p, "w %llu %u %u", &start, &boundary, &led) != 3)
+        continue;
+      win.start_us = start;
+      win.db_boundary = boundary;
+      win.led_enabled = led != 0;
+      win.count = 0;
+      win.dropped = 0;
+      in_window = true;
+    } else if (p[0] == 's' && in_window) {
+      // "s <adc>"; gravações anteriores traziam também o instante: "s <dt_us> <adc>"
+      unsigned long first;
+      unsigned int sample;
+      int fields = sscanf(p, "s %lu %u", &first, &sample);
+      if (fields == 1)
+        window_push(&win, (uint16_t)first);
+      else if (fields == 2)
+        window_push(&win, (uint16_t)sample);
+    } else if (p[0] == 'e' && in_window) {
+      unsigned long end, n, dropped;
+      if (sscanf(p, "e %lu %lu %lu", &end, &n, &dropped) != 3)
+        continue;
+      in_window = false;
+      win.end_us = (uint32_t)end;
+      win.dropped = (uint32_t)dropped;
+
+      if (n != win.count) {
+        fprintf(stderr, "janela %zu: gravação incompleta (%lu de %zu amostras), ignorada\n", windows, n, win.count);
+        continue;
+      }
+      // Janela truncada (amostras além da memória do gravador): o resultado não
+      // corresponderia ao que o firmware mediu
+      if (win.dropped) {
+        fprintf(stderr, "janela %zu: truncada, %" PRIu32 " amostras além da memória do gravador, rejeitada\n", windows,
+                win.dropped);
+        dropped_windows++;
+        continue;
+      }
+
+      if (!have_first) {
+        first_us = win.start_us;
+        have_first = true;
+        governor_init(&governor, &governor_default_config, 0);
+      }
+
+      // Medição e alarme. Como no firmware, janelas saturadas mantêm o último nível válido
+      result_t r = { .index = windows };
+      uint64_t t0 = now_ns();
+      level_window_t lw;
+      uint8_t alarm_amount;
+      level_window_reset(&lw);
+      for (size_t i = 0; i < win.count; ++i)
+        level_window_push(&lw, win.samples[i]);
+      level_reading_update(&reading, &lw);
+      if (reading.valid)
+        level_noise_update(&noise, reading.peak_to_peak);
+      else
+        overload_windows++;
+      r.peak_to_peak = reading.peak_to_peak;
+      r.db = reading.db;
+      r.flags = reading.flags;
+      r.alarm = level_alarm_level(&reading, win.db_boundary, win.led_enabled, &alarm_amount);
+      r.samples = lw.count;
+      r.t_ms = (win.start_us + win.end_us - first_us) / 1000;
+      uint64_t t1 = now_ns();
+
+      // Desenho da página de visualização, como no laço principal
+      display_clean_main_area(&ssd);
+      display_draw_measurement(&ssd, r.db, r.flags);
+      display_draw_header_level(&ssd, win.db_boundary);
+      uint64_t t2 = now_ns();
+
+      // Governador sobre o relógio virtual (sem botões na gravação)
+      governor.cfg.wake_db = win.db_boundary;
+      governor_update(&governor, (uint32_t)r.t_ms, r.flags & LEVEL_FLAG_OVERLOAD ? GOVERNOR_DB_OVERLOAD : r.db);
+      if (governor_refresh_due(&governor, (uint32_t)r.t_ms))
+        refreshes++;
+
+      measure_ns += t1 - t0;
+      render_ns += t2 - t1;
+      total_samples += win.count;
+
+      bool transition = have_prev && r.alarm != prev_alarm;
+      if (transition)
+        cmp.transitions++;
+
+      // Tela de visualização (PAGE_MEASUREMENT = 1)
+      mirror_capture(&mirror, ssd.ram_buffer + 1, 1, (uint32_t)r.t_ms);
+      size_t mirror_len = mirror_encode(&mirror, mirror_line, sizeof(mirror_line));
+      if (mirror_len > 0) {
+        mirror_frames++;
+        mirror_bytes += mirror_len;
+      }
+
+      bool fb_changed = !have_prev || memcmp(last_fb, ssd.ram_buffer, ssd.bufsize) != 0;
+      memcpy(last_fb, ssd.ram_buffer, ssd.bufsize);
+      prev_alarm = r.alarm;
+      have_prev = true;
+
+      if (out != NULL) {
+        fprintf(out, "g %zu %" PRIu64 " %" PRIu32 " %u %u %u %u\n", r.index, r.t_ms, r.samples, r.peak_to_peak, r.db,
+                (unsigned int)r.alarm, r.flags);
+        if (fb_changed)
+          write_framebuffer(out, ssd.ram_buffer, ssd.bufsize);
+      }
+
+      if (golden.file != NULL) {
+        result_t g;
+        if (golden_next(&golden, &g) < 0) {
+          report(&cmp, &r, "ausente na referência");
+        } else {
+          unsigned int db_diff = r.db > g.db ? r.db - g.db : g.db - r.db;
+          unsigned int px;
+
+          if (g.samples != r.samples)
+            report(&cmp, &r, "amostras %" PRIu32 ", referência %" PRIu32, r.samples, g.samples);
+          if (db_diff > cmp.db_tol)
+            report(&cmp, &r, "%u dB, referência %u dB", r.db, g.db);
+          if (g.flags != r.flags)
+            report(&cmp, &r, "indicadores %u, referência %u", r.flags, g.flags);
+          if (g.alarm != r.alarm)
+            report(&cmp, &r, "alarme %s, referência %s", alarm_name(r.alarm), alarm_name(g.alarm));
+          if ((px = pixel_diff(golden.framebuffer, ssd.ram_buffer, ssd.bufsize)) > cmp.fb_tol)
+            report(&cmp, &r, "%u pixels diferentes no quadro", px);
+        }
+      }
+
+      windows++;
+    }
+  }
+
+  if (golden.file != NULL) {
+    result_t g;
+    if (golden_next(&golden, &g) == 0) {
+      fprintf(stderr, "referência tem mais janelas que a gravação\n");
+      cmp.mismatches++;
+    }
+    fclose(golden.file);
+  }
+  if (out != NULL)
+    fclose(out);
+  fclose(in);
+  free(line);
+  free(win.samples);
+
+  // Vazão do pipeline (medição + desenho)
+  double measure_s = measure_ns / 1e9, render_s = render_ns / 1e9;
+  fprintf(stderr, "janelas: %zu, amostras: %zu, transições do alarme: %zu, janelas truncadas: %zu\n", windows,
+          total_samples, cmp.transitions, dropped_windows);
+  fprintf(stderr, "janelas saturadas: %zu, piso de ruído: %u, faixa dinâmica: %u dB\n", overload_windows,
+          level_noise_floor(&noise), level_dynamic_range_db(&noise));
+  fprintf(stderr, "medição: %.3e amostras/s, desenho: %.3e quadros/s, pipeline: %.3e janelas/s\n",
+          measure_s > 0 ? total_samples / measure_s : 0.0, render_s > 0 ? windows / render_s : 0.0,
+          measure_s + render_s > 0 ? windows / (measure_s + render_s) : 0.0);
+
+  if (have_first) {
+    char residency[128];
+    governor_format_residency(&governor, residency, sizeof(residency));
+    fprintf(stderr, "governador: %s, atualizações da GUI: %zu de %zu janelas\n", residency, refreshes, windows);
+    fprintf(stderr, "espelhamento: %zu quadros enviados, %.1f B por janela, %.1f B por quadro enviado\n",
+            mirror_frames, (double)mirror_bytes / (double)windows,
+            mirror_frames ? (double)mirror_bytes / (double)mirror_frames : 0.0);
+  }
+
+  // Uma gravação com janelas truncadas não serve de referência nem passa na comparação
+  if (dropped_windows) {
+    fprintf(stderr, "FALHOU: %zu janelas truncadas (grave com janelas de medição mais curtas)\n", dropped_windows);
+    if (write_path != NULL)
+      remove(write_path);
+    return 1;
+  }
+
+  if (golden_path != NULL) {
+    if (cmp.mismatches) {
+      fprintf(stderr, "FALHOU: %zu divergências\n", cmp.mismatches);
+      return 1;
+    }
+    fprintf(stderr, "OK: resultado igual à referência\n");
+  }
+
+  return 0;
+}
@@ -0,0 +1,170 @@
+// Receptor da telemetria UDP (firmware compilado com DECIMETER_TELEMETRY).
+//
+// Recebe os datagramas, confere a sequência dos registros e informa, a cada
+// intervalo e ao final, os registros por segundo, os descartados pela fila do
+// emissor (rede lenta ou fora do ar) e os perdidos na rede (lacunas restantes).
+// Serve também para medir o decimeter_telemetry_tx pela interface de loopback.
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "inc/net/telemetry.h"
+
+#define DEFAULT_PORT 5005
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig) {
+  (void)sig;
+  stop = 1;
+}
+
+static uint64_t now_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+}
+
+static void print_stats(const char *label, const telemetry_rx_stats_t *s, const telemetry_rx_stats_t *base,
+                        uint64_t elapsed_ms) {
+  uint64_t records = s->records - base->records;
+  uint64_t dropped = s->dropped - base->dropped;
+  uint64_t lost = s->lost - base->lost;
+  uint64_t expected = records + dropped + lost;
+
+  fprintf(stderr,
+          "%s: %.1f registros/s, datagramas %" PRIu64 ", registros %" PRIu64 ", descartados pelo emissor %" PRIu64
+          ", perdidos na rede %" PRIu64 " (%.2f%%), fora de ordem %" PRIu64 ", inválidos %" PRIu64 "\n",
+          label, elapsed_ms ? records * 1000.0 / elapsed_ms : 0.0, s->datagrams - base->datagrams, records, dropped,
+          lost, expected ? 100.0 * (dropped + lost) / expected : 0.0, s->out_of_order - base->out_of_order,
+          s->invalid - base->invalid);
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "uso: %s [opções]\n"
+          "  -p, --port N       porta UDP (padrão %d)\n"
+          "  -b, --bind END     endereço local (padrão 0.0.0.0)\n"
+          "  -d, --duration S   encerra após S segundos (padrão: até Ctrl+C)\n"
+          "  -i, --interval S   intervalo entre relatórios (padrão 1 s, 0 desativa)\n"
+          "  -v, --verbose      exibe cada registro recebido\n",
+          prog, DEFAULT_PORT);
+}
+
+int main(int argc, char **argv) {
+  static const struct option options[] = {
+    { "port", required_argument, NULL, 'p' },
+    { "bind", required_argument, NULL, 'b' },
+    { "duration", required_argument, NULL, 'd' },
+    { "interval", required_argument, NULL, 'i' },
+    { "verbose", no_argument, NULL, 'v' },
+    { "help", no_argument, NULL, 'h' },
+    { NULL, 0, NULL, 0 }
+  };
+  unsigned port = DEFAULT_PORT;
+  const char *bind_addr = "0.0.0.0";
+  double duration = 0, interval = 1;
+  int verbose = 0;
+  int opt;
+
+  while ((opt = getopt_long(argc, argv, "p:b:d:i:vh", options, NULL)) != -1) {
+    switch (opt) {
+    case 'p': port = (unsigned)strtoul(optarg, NULL, 10); break;
+    case 'b': bind_addr = optarg; break;
+    case 'd': duration = strtod(optarg, NULL); break;
+    case 'i': interval = strtod(optarg, NULL); break;
+    case 'v': verbose = 1; break;
+    default:
+      usage(argv[0]);
+      return opt == 'h' ? 0 : 2;
+    }
+  }
+
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) {
+    perror("socket");
+    return 1;
+  }
+
+  // Buffer de recepção maior, para medir a rede e não o receptor
+  int rcvbuf = 4 << 20;
+  setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+  struct sockaddr_in addr = { .sin_family = AF_INET, .sin_port = htons((uint16_t)port) };
+  if (inet_pton(AF_INET, bind_addr, &addr.sin_addr) != 1) {
+    fprintf(stderr, "endereço inválido: %s\n", bind_addr);
+    return 2;
+  }
+  if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    perror("bind");
+    return 1;
+  }
+
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+
+  static uint8_t buf[65536];
+  static telemetry_record_t records[255];
+  telemetry_rx_t rx;
+  telemetry_rx_stats_t last = { 0 };
+  uint64_t start = 0, last_report = 0;
+
+  telemetry_rx_init(&rx);
+
+  fprintf(stderr, "aguardando telemetria em %s:%u\n", bind_addr, port);
+
+  while (!stop) {
+    uint64_t now = now_ms();
+
+    if (start && duration > 0 && now - start >= (uint64_t)(duration * 1000))
+      break;
+    if (start && interval > 0 && now - last_report >= (uint64_t)(interval * 1000)) {
+      print_stats("intervalo", &rx.stats, &last, now - last_report);
+      last = rx.stats;
+      last_report = now;
+    }
+
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+    int ready = poll(&pfd, 1, 100);
+    if (ready < 0 && errno != EINTR) {
+      perror("poll");
+      return 1;
+    }
+    if (ready <= 0)
+      continue;
+
+    ssize_t len = recv(fd, buf, sizeof(buf), 0);
+    if (len < 0)
+      continue;
+
+    // O tempo conta a partir do primeiro datagrama
+    if (!start)
+      start = last_report = now_ms();
+
+    telemetry_header_t h;
+    int n = telemetry_rx_receive(&rx, buf, (size_t)len, &h, records, sizeof(records) / sizeof(records[0]));
+    if (n <= 0)
+      continue;
+
+    if (verbose) {
+      for (int i = 0; i < n; ++i)
+        printf("%" PRIu32 " %" PRIu32 " %u %u %u %u\n", h.first_seq + (uint32_t)i, records[i].t_ms,
+               records[i].peak_to_peak, records[i].db, records[i].flags, records[i].alarm);
+    }
+  }
+
+  close(fd);
+  print_stats("total", &rx.stats, &(telemetry_rx_stats_t){ 0 }, start ? now_ms() - start : 0);
+  return 0;
+}
@@ -0,0 +1,150 @@
+// Emissor de telemetria sintética para testar o decimeter_telemetry_rx.
+//
+// Simula o laço do firmware: gera registros a uma taxa fixa, coloca-os na mesma
+// fila de inc/net/telemetry.c e envia os datagramas pelo mesmo critério de lote.
+// A opção --stall interrompe o envio por um tempo, como uma rede fora do ar,
+// para mostrar a fila descartando os registros mais antigos sem atrasar a geração.
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <getopt.h>
+#include <math.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "inc/net/telemetry.h"
+
+#define DEFAULT_PORT 5005
+#define DEFAULT_RATE 20 // uma medição a cada 50 ms, como no firmware
+
+static uint64_t now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static void sleep_until_us(uint64_t t) {
+  uint64_t now = now_us();
+  if (t <= now)
+    return;
+  struct timespec ts = { .tv_sec = (time_t)((t - now) / 1000000u), .tv_nsec = (long)((t - now) % 1000000u) * 1000 };
+  nanosleep(&ts, NULL);
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "uso: %s [opções]\n"
+          "  -H, --host END       destino (padrão 127.0.0.1)\n"
+          "  -p, --port N         porta UDP (padrão %d)\n"
+          "  -r, --rate N         registros por segundo (padrão %d)\n"
+          "  -d, --duration S     duração em segundos (padrão 10)\n"
+          "  -i, --interval MS    intervalo máximo entre datagramas (padrão 1000)\n"
+          "  -s, --stall MS       interrompe o envio por MS ms no meio da execução\n",
+          prog, DEFAULT_PORT, DEFAULT_RATE);
+}
+
+int main(int argc, char **argv) {
+  static const struct option options[] = {
+    { "host", required_argument, NULL, 'H' },
+    { "port", required_argument, NULL, 'p' },
+    { "rate", required_argument, NULL, 'r' },
+    { "duration", required_argument, NULL, 'd' },
+    { "interval", required_argument, NULL, 'i' },
+    { "stall", required_argument, NULL, 's' },
+    { "help", no_argument, NULL, 'h' },
+    { NULL, 0, NULL, 0 }
+  };
+  const char *host = "127.0.0.1";
+  unsigned port = DEFAULT_PORT;
+  double rate = DEFAULT_RATE, duration = 10;
+  uint32_t interval_ms = 1000, stall_ms = 0;
+  int opt;
+
+  while ((opt = getopt_long(argc, argv, "H:p:r:d:i:s:h", options, NULL)) != -1) {
+    switch (opt) {
+    case 'H': host = optarg; break;
+    case 'p': port = (unsigned)strtoul(optarg, NULL, 10); break;
+    case 'r': rate = strtod(optarg, NULL); break;
+    case 'd': duration = strtod(optarg, NULL); break;
+    case 'i': interval_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+    case 's': stall_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+    default:
+      usage(argv[0]);
+      return opt == 'h' ? 0 : 2;
+    }
+  }
+
+  if (rate <= 0 || duration <= 0) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) {
+    perror("socket");
+    return 1;
+  }
+
+  struct sockaddr_in addr = { .sin_family = AF_INET, .sin_port = htons((uint16_t)port) };
+  if (inet_pton(AF_INET, host, &addr.sin_addr) != 1) {
+    fprintf(stderr, "endereço inválido: %s\n", host);
+    return 2;
+  }
+
+  static telemetry_t t;
+  static uint8_t datagram[TELEMETRY_MAX_DATAGRAM];
+  uint64_t start = now_us();
+  uint64_t total = (uint64_t)(rate * duration);
+  uint64_t stall_start = (uint64_t)(duration * 1e6 / 2), stall_end = stall_start + (uint64_t)stall_ms * 1000;
+  unsigned long sent = 0, send_errors = 0;
+
+  telemetry_init(&t, interval_ms, 0);
+
+  for (uint64_t i = 0; i < total; ++i) {
+    sleep_until_us(start + (uint64_t)(i * 1e6 / rate));
+    uint64_t elapsed = now_us() - start;
+    uint32_t ms = (uint32_t)(elapsed / 1000);
+
+    // Nível sintético: senoide lenta entre 40 e 80 dB
+    unsigned db = (unsigned)(60 + 20 * sin(2 * M_PI * (double)elapsed / 10e6));
+    telemetry_record_t r = {
+      .t_ms = ms,
+      .peak_to_peak = (uint16_t)pow(10.0, db / 20.0),
+      .db = (uint8_t)db,
+      .flags = 0,
+      .alarm = db > 70,
+    };
+    telemetry_push(&t, &r);
+
+    // Rede "fora do ar": os registros se acumulam e a fila descarta os mais antigos
+    if (stall_ms && elapsed >= stall_start && elapsed < stall_end)
+      continue;
+
+    while (telemetry_due(&t, ms)) {
+      size_t len = telemetry_encode(&t, datagram, sizeof(datagram), ms);
+      if (sendto(fd, datagram, len, MSG_DONTWAIT, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+        send_errors++;
+      else
+        sent++;
+    }
+  }
+
+  // Esvazia a fila
+  while (t.count > 0) {
+    size_t len = telemetry_encode(&t, datagram, sizeof(datagram), 0);
+    if (sendto(fd, datagram, len, 0, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+      send_errors++;
+    else
+      sent++;
+  }
+
+  close(fd);
+  fprintf(stderr, "registros gerados: %llu, descartados pela fila: %u, datagramas: %lu, falhas de envio: %lu\n",
+          (unsigned long long)total, t.dropped, sent, send_errors);
+  return 0;
+}
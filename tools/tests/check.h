@@ -0,0 +1,39 @@
+#ifndef __CHECK_INC
+#define __CHECK_INC
+
+// Verificações dos testes executados com ctest. Cada falha é impressa com o
+// arquivo e a linha e contada; o teste termina com check_result().
+
+#include <stdio.h>
+
+static int check_failures;
+
+#define CHECK(cond)                                                          \
+  do {                                                                       \
+    if (!(cond)) {                                                           \
+      fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond);     \
+      check_failures++;                                                      \
+    }                                                                        \
+  } while (0)
+
+// Compara dois inteiros e mostra os valores em caso de falha
+#define CHECK_EQ(a, b)                                                       \
+  do {                                                                       \
+    long long check_a = (long long)(a), check_b = (long long)(b);            \
+    if (check_a != check_b) {                                                \
+      fprintf(stderr, "%s:%d: falhou: %s == %s (%lld != %lld)\n", __FILE__,  \
+              __LINE__, #a, #b, check_a, check_b);                           \
+      check_failures++;                                                      \
+    }                                                                        \
+  } while (0)
+
+// Código de saída do teste (0 = sucesso)
+static inline int check_result(const char *name) {
+  if (check_failures)
+    fprintf(stderr, "%s: %d falha(s)\n", name, check_failures);
+  else
+    printf("%s: ok\n", name);
+  return check_failures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,142 @@
+// Garante que o driver do display e o das cadeias de LEDs não usam o heap: duas
+// instâncias declaradas com SSD1306_DEFINE são inicializadas, desenhadas e enviadas
+// pelo substituto do I2C, e duas cadeias declaradas com NP_STRIP_DEFINE são
+// inicializadas e escritas pelo substituto do PIO, enquanto malloc e calloc são
+// interceptados (-Wl,--wrap).
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "inc/ssd1306/ssd1306.h"
+#include "inc/matriz/neopixel.h"
+#include "check.h"
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+
+// volatile: o compilador supõe que malloc não lê variáveis do programa
+static volatile bool counting;
+static unsigned allocations;
+
+void *__wrap_malloc(size_t size) {
+  if (counting)
+    allocations++;
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+  if (counting)
+    allocations++;
+  return __real_calloc(n, size);
+}
+
+SSD1306_DEFINE(ssd_a, WIDTH, HEIGHT);
+SSD1306_DEFINE(ssd_b, WIDTH, 32);
+NP_STRIP_DEFINE(strip_a, NP_MATRIX_LEDS);
+NP_STRIP_DEFINE(strip_b, 8);
+
+// Bytes enviados a cada endereço do barramento
+static size_t sent_a, sent_b;
+
+static void capture(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len) {
+  (void)i2c;
+  (void)src;
+  if (addr == 0x3C)
+    sent_a += len;
+  else if (addr == 0x3D)
+    sent_b += len;
+}
+
+// Palavras recebidas por cada máquina do pio0
+#define MAX_WORDS 32
+static uint32_t words[NUM_PIO_STATE_MACHINES][MAX_WORDS];
+static unsigned word_count[NUM_PIO_STATE_MACHINES];
+
+static void capture_pio(PIO pio, uint sm, uint32_t data) {
+  if (pio != pio0)
+    return;
+  if (word_count[sm] < MAX_WORDS)
+    words[sm][word_count[sm]] = data;
+  word_count[sm]++;
+}
+
+int main(void) {
+  // A interceptação precisa funcionar, senão o teste passaria sem verificar nada
+  void *volatile block;
+  counting = true;
+  block = malloc(16);
+  free(block);
+  block = calloc(1, 16);
+  free(block);
+  counting = false;
+  CHECK_EQ(allocations, 2);
+  allocations = 0;
+
+  host_i2c_capture = capture;
+  host_pio_capture = capture_pio;
+  counting = true;
+
+  CHECK(ssd1306_init(&ssd_a, WIDTH, HEIGHT, false, 0x3C, i2c0));
+  CHECK(ssd1306_init(&ssd_b, WIDTH, 32, false, 0x3D, i2c1));
+  ssd1306_config(&ssd_a);
+  ssd1306_config(&ssd_b);
+
+  ssd1306_fill(&ssd_a, false);
+  ssd1306_rect(&ssd_a, 3, 3, 122, 58, true, false);
+  ssd1306_draw_string(&ssd_a, "DECIBELIMETRO", 8, 10);
+  ssd1306_line(&ssd_a, 0, 0, 127, 63, true);
+  ssd1306_fill(&ssd_b, true);
+  ssd1306_draw_string(&ssd_b, "60 DB", 20, 12);
+  sent_a = sent_b = 0;
+  ssd1306_send_data(&ssd_a);
+  ssd1306_send_data(&ssd_b);
+  size_t flush_a = sent_a, flush_b = sent_b;
+  ssd1306_set_contrast(&ssd_a, 0x10);
+  ssd1306_set_power(&ssd_b, false);
+
+  CHECK(npInit(&strip_a, 7));
+  CHECK(npInit(&strip_b, 8));
+  npSetLED(&strip_a, 0, 80, 0, 0);
+  npSetLED(&strip_b, 7, 0, 0, 255);
+  host_sleep_us = 0;
+  npWrite(&strip_a);
+  uint64_t latch_us = host_sleep_us;
+  npWrite(&strip_b);
+
+  counting = false;
+  CHECK_EQ(allocations, 0);
+
+  // Buffers separados, do tamanho de cada display, e desenhos independentes
+  CHECK(ssd_a.ram_buffer != ssd_b.ram_buffer);
+  CHECK_EQ(ssd_a.bufsize, SSD1306_BUFSIZE(WIDTH, HEIGHT));
+  CHECK_EQ(ssd_b.bufsize, SSD1306_BUFSIZE(WIDTH, 32));
+  CHECK_EQ(ssd_b.ram_buffer[1], 0xFF);
+  CHECK(ssd_a.ram_buffer[1] != 0xFF);
+
+  // Cada instância envia o próprio framebuffer ao seu endereço: 6 comandos de
+  // endereçamento (2 bytes cada) e os dados precedidos do byte de controle
+  CHECK_EQ(flush_a, 6 * 2 + ssd_a.bufsize);
+  CHECK_EQ(flush_b, 6 * 2 + ssd_b.bufsize);
+
+  // Cadeias com buffers próprios, máquinas distintas no mesmo bloco PIO e o
+  // programa carregado uma única vez
+  CHECK(strip_a.leds != strip_b.leds);
+  CHECK_EQ(strip_a.led_count, NP_MATRIX_LEDS);
+  CHECK_EQ(strip_b.led_count, 8);
+  CHECK(strip_a.pio == pio0 && strip_b.pio == pio0);
+  CHECK(strip_a.sm != strip_b.sm);
+  CHECK_EQ(host_pio_programs[0], 1);
+  CHECK_EQ(host_pio_programs[1], 0);
+
+  // Cada cadeia envia uma palavra por LED à própria máquina
+  CHECK_EQ(word_count[strip_a.sm], NP_MATRIX_LEDS);
+  CHECK_EQ(word_count[strip_b.sm], 8);
+  CHECK_EQ(words[strip_a.sm][0], NP_GRB(80, 0, 0));
+  CHECK_EQ(words[strip_a.sm][1], 0);
+  CHECK_EQ(words[strip_b.sm][7], NP_GRB(0, 0, 255));
+
+  // Após o último LED, a linha fica em nível baixo pela pausa de latch
+  CHECK(latch_us >= NP_LATCH_US);
+
+  return check_result("alloc");
+}
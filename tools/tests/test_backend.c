@@ -0,0 +1,148 @@
+// Sequência de bytes enviada ao display por uma combinação de controlador e
+// barramento (DISPLAY_CONTROLLER / DISPLAY_TRANSPORT, uma compilação para cada),
+// comparada com a captura salva em data/.
+//
+//   test_backend_<nome> data/<nome>.txt           compara
+//   test_backend_<nome> --write data/<nome>.txt   refaz a captura
+//
+// Cada linha da captura é uma transação no barramento:
+//   i2c <endereço> <bytes>
+//   spi c|d <bytes>   (c = pino DC em 0, comando; d = DC em 1, dado)
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "inc/ssd1306/ssd1306.h"
+#include "check.h"
+
+#define DISPLAY_ADDRESS 0x3C
+#define DISPLAY_CS_PIN 17
+#define DISPLAY_DC_PIN 16
+
+SSD1306_DEFINE(ssd, WIDTH, HEIGHT);
+
+static FILE *capture_out;
+
+static void capture_bytes(const uint8_t *src, size_t len) {
+  for (size_t i = 0; i < len; ++i)
+    fprintf(capture_out, "%02x", src[i]);
+  fputc('\n', capture_out);
+}
+
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+static void capture_spi(spi_inst_t *spi, const uint8_t *src, size_t len) {
+  CHECK(spi == spi0);
+  CHECK(!gpio_get(DISPLAY_CS_PIN)); // display selecionado durante a transação
+  fprintf(capture_out, "spi %c ", gpio_get(DISPLAY_DC_PIN) ? 'd' : 'c');
+  capture_bytes(src, len);
+}
+#else
+static void capture_i2c(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len) {
+  CHECK(i2c == i2c1);
+  fprintf(capture_out, "i2c %02x ", addr);
+  capture_bytes(src, len);
+}
+#endif
+
+// Inicialização, um quadro de teste e os comandos de contraste e energia
+static void run_display(void) {
+  fputs("# configuracao\n", capture_out);
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+  CHECK(ssd1306_init_spi(&ssd, WIDTH, HEIGHT, false, spi0, DISPLAY_CS_PIN, DISPLAY_DC_PIN));
+#else
+  CHECK(ssd1306_init(&ssd, WIDTH, HEIGHT, false, DISPLAY_ADDRESS, i2c1));
+#endif
+  ssd1306_config(&ssd);
+
+  fputs("# quadro\n", capture_out);
+  ssd1306_fill(&ssd, false);
+  ssd1306_rect(&ssd, 3, 3, 122, 58, true, false);
+  ssd1306_draw_string(&ssd, "65 DB", 8, 10);
+  ssd1306_line(&ssd, 0, 63, 127, 0, true);
+  ssd1306_send_data(&ssd);
+
+  fputs("# contraste e energia\n", capture_out);
+  ssd1306_set_contrast(&ssd, 0x10);
+  ssd1306_set_power(&ssd, false);
+
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+  CHECK(gpio_get(DISPLAY_CS_PIN)); // CS liberado ao final
+#endif
+}
+
+static char *read_file(const char *path, size_t *len) {
+  FILE *f = fopen(path, "r");
+  char *buf = NULL;
+  size_t cap = 0;
+
+  if (f == NULL)
+    return NULL;
+  FILE *mem = open_memstream(&buf, &cap);
+  int c;
+  while ((c = fgetc(f)) != EOF)
+    fputc(c, mem);
+  fclose(f);
+  fclose(mem);
+  *len = cap;
+  return buf;
+}
+
+// Indica a primeira linha diferente entre a captura e a referência
+static void report_difference(const char *got, const char *expected) {
+  unsigned line = 1;
+
+  while (*got && *got == *expected) {
+    if (*got == '\n')
+      line++;
+    got++;
+    expected++;
+  }
+  fprintf(stderr, "linha %u difere da captura salva\n", line);
+}
+
+int main(int argc, char **argv) {
+  bool write = argc == 3 && strcmp(argv[1], "--write") == 0;
+  const char *path = argv[argc - 1];
+  char *got = NULL;
+  size_t got_len = 0;
+
+  if (argc != 2 && !write) {
+    fprintf(stderr, "uso: %s [--write] captura.txt\n", argv[0]);
+    return 2;
+  }
+
+  capture_out = open_memstream(&got, &got_len);
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+  host_spi_capture = capture_spi;
+#else
+  host_i2c_capture = capture_i2c;
+#endif
+  run_display();
+  fclose(capture_out);
+
+  if (write) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+      perror(path);
+      return 1;
+    }
+    fwrite(got, 1, got_len, f);
+    fclose(f);
+  } else {
+    size_t expected_len;
+    char *expected = read_file(path, &expected_len);
+    if (expected == NULL) {
+      perror(path);
+      return 1;
+    }
+    if (expected_len != got_len || memcmp(expected, got, got_len) != 0) {
+      report_difference(got, expected);
+      check_failures++;
+    }
+    free(expected);
+  }
+
+  free(got);
+  return check_result(path);
+}
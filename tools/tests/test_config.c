@@ -0,0 +1,273 @@
+// Configurações (inc/config/config.h) sobre um armazenamento em RAM com a mesma
+// semântica da flash: a gravação só leva bits de 1 para 0 e o apagamento volta
+// o setor inteiro para 0xFF. Cobre o agrupamento das gravações, a volta ao início
+// do setor, o descarte de registros com CRC inválido, falhas de gravação e as
+// leituras sem bloqueio (seqlock): leitura durante uma escrita e várias threads
+// lendo enquanto outra escreve.
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+#include "inc/config/config.h"
+#include "check.h"
+
+#define RAM_SIZE 4096
+#define RAM_PAGE 256
+#define RAM_PAGES (RAM_SIZE / RAM_PAGE)
+
+static uint8_t ram[RAM_SIZE];
+static bool fail_program;
+
+static void ram_read(void *ctx, uint32_t offset, void *dst, size_t len) {
+  (void)ctx;
+  memcpy(dst, ram + offset, len);
+}
+
+static bool ram_program(void *ctx, uint32_t offset, const void *src, size_t len) {
+  const uint8_t *p = src;
+  (void)ctx;
+  if (fail_program)
+    return false;
+  for (size_t i = 0; i < len; ++i)
+    ram[offset + i] &= p[i];
+  return true;
+}
+
+static bool ram_erase(void *ctx) {
+  (void)ctx;
+  memset(ram, 0xFF, sizeof(ram));
+  return true;
+}
+
+static const config_backend_t ram_backend = {
+  .size = RAM_SIZE,
+  .page_size = RAM_PAGE,
+  .read = ram_read,
+  .program = ram_program,
+  .erase = ram_erase,
+  .ctx = NULL,
+};
+
+// Altera o limite e aguarda a gravação
+static void save_boundary(config_store_t *s, uint16_t db, uint32_t *now) {
+  config_values_t v;
+  config_read(s, &v);
+  v.db_boundary = db;
+  config_write(s, &v);
+  config_service(s, *now);
+  *now += s->save_delay_ms;
+  CHECK_EQ(config_service(s, *now), CONFIG_SAVED);
+  *now += 1000;
+}
+
+static uint16_t stored_boundary(void) {
+  config_store_t s;
+  config_values_t v;
+  CHECK(config_init(&s, &ram_backend, &config_defaults));
+  config_read(&s, &v);
+  return v.db_boundary;
+}
+
+// Leituras concorrentes: cada escrita mantém a relação entre os campos, então uma
+// cópia com campos de escritas diferentes é detectada
+static config_store_t shared;
+static atomic_bool stop_readers;
+
+typedef struct {
+  unsigned long reads;
+  unsigned long torn;
+} reader_stats_t;
+
+static void *reader(void *arg) {
+  reader_stats_t *stats = arg;
+
+  while (!atomic_load(&stop_readers)) {
+    config_values_t v;
+    config_read(&shared, &v);
+    stats->reads++;
+    if (v.sample_window_ms != v.db_boundary + CONFIG_WINDOW_MIN_MS || v.brightness != v.db_boundary + 1)
+      stats->torn++;
+  }
+  return NULL;
+}
+
+// Escrita em andamento (seq ímpar, valores pela metade): a leitura deve esperar
+// e devolver apenas os valores completos
+static atomic_bool reader_done;
+
+static void *blocked_reader(void *arg) {
+  config_read(&shared, arg);
+  atomic_store(&reader_done, true);
+  return NULL;
+}
+
+static void test_read_during_write(void) {
+  const struct timespec wait = { 0, 20 * 1000 * 1000 };
+  config_values_t v;
+  pthread_t thread;
+
+  memset(ram, 0xFF, sizeof(ram));
+  config_init(&shared, &ram_backend, &config_defaults);
+  uint32_t seq = atomic_load(&shared.seq);
+
+  atomic_store(&shared.seq, seq + 1);
+  shared.values.db_boundary = 90;
+  atomic_store(&reader_done, false);
+  pthread_create(&thread, NULL, blocked_reader, &v);
+  nanosleep(&wait, NULL);
+  CHECK(!atomic_load(&reader_done));
+
+  shared.values.sample_window_ms = 100;
+  atomic_store(&shared.seq, seq + 2);
+  pthread_join(thread, NULL);
+  CHECK_EQ(v.db_boundary, 90);
+  CHECK_EQ(v.sample_window_ms, 100);
+}
+
+static void test_concurrent_reads(void) {
+  enum { READERS = 3, WRITES = 1000000 };
+  pthread_t threads[READERS];
+  reader_stats_t stats[READERS];
+  config_values_t v = config_defaults;
+
+  memset(ram, 0xFF, sizeof(ram));
+  config_init(&shared, &ram_backend, &config_defaults);
+  v.db_boundary = 0;
+  v.sample_window_ms = CONFIG_WINDOW_MIN_MS;
+  v.brightness = 1;
+  config_write(&shared, &v);
+
+  memset(stats, 0, sizeof(stats));
+  atomic_store(&stop_readers, false);
+  for (int i = 0; i < READERS; ++i)
+    pthread_create(&threads[i], NULL, reader, &stats[i]);
+
+  for (int i = 0; i < WRITES; ++i) {
+    v.db_boundary = (uint16_t)(i % CONFIG_DB_MAX);
+    v.sample_window_ms = v.db_boundary + CONFIG_WINDOW_MIN_MS;
+    v.brightness = (uint8_t)(v.db_boundary + 1);
+    config_write(&shared, &v);
+  }
+
+  atomic_store(&stop_readers, true);
+  unsigned long reads = 0, torn = 0;
+  for (int i = 0; i < READERS; ++i) {
+    pthread_join(threads[i], NULL);
+    reads += stats[i].reads;
+    torn += stats[i].torn;
+  }
+  CHECK(reads > 0);
+  CHECK_EQ(torn, 0);
+}
+
+int main(void) {
+  config_store_t s;
+  config_values_t v;
+  uint32_t now = 0;
+
+  // Armazenamento apagado: valores padrão
+  memset(ram, 0xFF, sizeof(ram));
+  CHECK(!config_init(&s, &ram_backend, &config_defaults));
+  config_read(&s, &v);
+  CHECK(memcmp(&v, &config_defaults, sizeof(v)) == 0);
+
+  // Ajustes em sequência: cada alteração reinicia a espera e só a última é gravada
+  for (uint16_t i = 0; i < 5; ++i) {
+    v.db_boundary = 70 + i;
+    config_write(&s, &v);
+    CHECK_EQ(config_service(&s, now), CONFIG_IDLE);
+    now += 500;
+  }
+  CHECK_EQ(config_service(&s, now + s.save_delay_ms - 600), CONFIG_IDLE);
+  now += s.save_delay_ms;
+  CHECK_EQ(config_service(&s, now), CONFIG_SAVED);
+  CHECK_EQ(s.saves, 1);
+  CHECK_EQ(config_service(&s, now + 10000), CONFIG_IDLE);
+  CHECK_EQ(stored_boundary(), 74);
+
+  // Limites aplicados na escrita
+  v.db_boundary = 999;
+  v.sample_window_ms = 1;
+  config_write(&s, &v);
+  config_read(&s, &v);
+  CHECK_EQ(v.db_boundary, CONFIG_DB_MAX);
+  CHECK_EQ(v.sample_window_ms, CONFIG_WINDOW_MIN_MS);
+
+  // Gravações em páginas sucessivas; cheio o setor, ele é apagado e a gravação volta ao início
+  now += 100000;
+  for (uint16_t i = 0; i < 40; ++i)
+    save_boundary(&s, i, &now);
+  CHECK_EQ(s.saves, 41);
+  CHECK_EQ(s.erases, 2);
+  CHECK_EQ(s.next_page, 41 - 2 * RAM_PAGES);
+  CHECK_EQ(stored_boundary(), 39);
+
+  // Recarregado, continua na página seguinte à mais recente
+  config_store_t reloaded;
+  config_init(&reloaded, &ram_backend, &config_defaults);
+  CHECK_EQ(reloaded.next_page, s.next_page);
+  CHECK_EQ(reloaded.record_sequence, s.record_sequence);
+
+  // CRC inválido no registro mais recente: vale o anterior
+  ram[(s.next_page - 1) * RAM_PAGE + offsetof(config_record_t, values)] ^= 0x01;
+  CHECK_EQ(stored_boundary(), 38);
+  // A página corrompida não está apagada: a próxima gravação apaga o setor antes
+  config_init(&s, &ram_backend, &config_defaults);
+  CHECK_EQ(s.next_page, RAM_PAGES);
+  save_boundary(&s, 45, &now);
+  CHECK_EQ(s.erases, 1);
+  CHECK_EQ(s.next_page, 1);
+  CHECK_EQ(stored_boundary(), 45);
+
+  // Falha na gravação: informada, e nova tentativa após a espera
+  fail_program = true;
+  config_read(&s, &v);
+  v.db_boundary = 99;
+  config_write(&s, &v);
+  config_service(&s, now);
+  now += s.save_delay_ms;
+  CHECK_EQ(config_service(&s, now), CONFIG_FAILED);
+  CHECK_EQ(s.failures, 1);
+  CHECK_EQ(config_service(&s, now + 1), CONFIG_IDLE);
+  fail_program = false;
+  now += s.save_delay_ms;
+  CHECK_EQ(config_service(&s, now), CONFIG_SAVED);
+  CHECK_EQ(stored_boundary(), 99);
+
+  // Sequência dando a volta: o registro 0 é mais recente que o 0xFFFFFFFF
+  memset(ram, 0xFF, sizeof(ram));
+  config_init(&s, &ram_backend, &config_defaults);
+  s.record_sequence = UINT32_MAX - 1;
+  save_boundary(&s, 10, &now);
+  save_boundary(&s, 11, &now);
+  CHECK_EQ(s.record_sequence, 0);
+  CHECK_EQ(stored_boundary(), 11);
+
+  // Registro de uma versão anterior, mais curto: os campos ausentes vêm dos valores padrão
+  memset(ram, 0xFF, sizeof(ram));
+  config_record_t old = {
+    .magic = CONFIG_MAGIC,
+    .version = 1,
+    .length = offsetof(config_values_t, brightness),
+    .sequence = 7,
+  };
+  uint8_t page[sizeof(config_record_t)];
+  old.values.db_boundary = 80;
+  old.values.sample_window_ms = 100;
+  memcpy(page, &old, offsetof(config_record_t, values) + old.length);
+  uint32_t crc = config_crc32(page, offsetof(config_record_t, values) + old.length);
+  memcpy(page + offsetof(config_record_t, values) + old.length, &crc, sizeof(crc));
+  ram_program(NULL, 0, page, offsetof(config_record_t, values) + old.length + sizeof(crc));
+  CHECK(config_init(&s, &ram_backend, &config_defaults));
+  config_read(&s, &v);
+  CHECK_EQ(v.db_boundary, 80);
+  CHECK_EQ(v.sample_window_ms, 100);
+  CHECK_EQ(v.brightness, config_defaults.brightness);
+  CHECK_EQ(v.led_enabled, config_defaults.led_enabled);
+
+  test_read_during_write();
+  test_concurrent_reads();
+
+  return check_result("config");
+}
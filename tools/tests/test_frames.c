@@ -0,0 +1,99 @@
+// Conteúdo das tabelas de quadros da matriz de LEDs (inc/matriz/frames.h):
+// mapeamento da matriz, preenchimento proporcional, cores da pulsação e da
+// varredura, e escolha do quadro pelo nível.
+
+#include <stdbool.h>
+#include "inc/matriz/frames.h"
+#include "check.h"
+
+// Componentes de uma palavra GRB
+#define GRB_R(w) (((w) >> 8) & 0xFF)
+#define GRB_G(w) ((w) & 0xFF)
+#define GRB_B(w) (((w) >> 16) & 0xFF)
+
+static unsigned lit_count(const uint32_t *frame) {
+  unsigned n = 0;
+  for (int i = 0; i < NP_MATRIX_LEDS; ++i)
+    n += frame[i] != 0;
+  return n;
+}
+
+int main(void) {
+  // Palavra GRB: G nos bits 0-7, R nos 8-15, B nos 16-23
+  CHECK_EQ(NP_GRB(0x11, 0x22, 0x33), 0x331122);
+
+  // Cada posição (linha, coluna) corresponde a exatamente um LED
+  bool seen[5][5] = { { false } };
+  for (int i = 0; i < NP_MATRIX_LEDS; ++i) {
+    CHECK(NP_ROW(i) >= 0 && NP_ROW(i) < 5 && NP_COL(i) >= 0 && NP_COL(i) < 5);
+    CHECK(!seen[NP_ROW(i)][NP_COL(i)]);
+    seen[NP_ROW(i)][NP_COL(i)] = true;
+  }
+  // Zigue-zague: LEDs vizinhos na cadeia são vizinhos na matriz
+  for (int i = 1; i < NP_MATRIX_LEDS; ++i) {
+    int dr = NP_ROW(i) - NP_ROW(i - 1), dc = NP_COL(i) - NP_COL(i - 1);
+    CHECK(dr * dr + dc * dc == 1);
+  }
+
+  // Preenchimento: o quadro k tem k LEDs acesos na cor do alarme, contidos no quadro k + 1,
+  // de baixo para cima (o quadro 5 acende a linha inferior)
+  CHECK_EQ(NP_FRAME_COUNT(np_frames_level), NP_MATRIX_LEDS + 1);
+  for (int k = 0; k <= NP_MATRIX_LEDS; ++k) {
+    CHECK_EQ(lit_count(np_frames_level[k]), k);
+    for (int i = 0; i < NP_MATRIX_LEDS; ++i) {
+      uint32_t px = np_frames_level[k][i];
+      CHECK(px == 0 || px == NP_ALARM_COLOR);
+      if (k < NP_MATRIX_LEDS && px != 0)
+        CHECK(np_frames_level[k + 1][i] != 0);
+    }
+  }
+  for (int i = 0; i < NP_MATRIX_LEDS; ++i)
+    CHECK_EQ(np_frames_level[5][i] != 0, NP_ROW(i) == 4);
+
+  // Pulsação: todos os LEDs com o mesmo vermelho, subindo até a cor do alarme e descendo
+  static const uint8_t pulse_red[] = { 8, 16, 32, 48, 64, 80, 64, 48, 32, 16 };
+  CHECK_EQ(NP_FRAME_COUNT(np_frames_pulse), sizeof(pulse_red));
+  for (int f = 0; f < NP_FRAME_COUNT(np_frames_pulse); ++f) {
+    for (int i = 0; i < NP_MATRIX_LEDS; ++i) {
+      uint32_t px = np_frames_pulse[f][i];
+      CHECK_EQ(GRB_R(px), pulse_red[f]);
+      CHECK_EQ(GRB_G(px), 0);
+      CHECK_EQ(GRB_B(px), 0);
+    }
+  }
+  CHECK_EQ(np_frames_pulse[5][0], NP_ALARM_COLOR);
+
+  // Varredura: uma coluna na cor do alarme (um LED por linha) sobre o fundo, indo e voltando
+  static const int sweep_col[] = { 0, 1, 2, 3, 4, 3, 2, 1 };
+  CHECK_EQ(NP_FRAME_COUNT(np_frames_sweep), sizeof(sweep_col) / sizeof(sweep_col[0]));
+  for (int f = 0; f < NP_FRAME_COUNT(np_frames_sweep); ++f) {
+    unsigned rows = 0;
+    for (int i = 0; i < NP_MATRIX_LEDS; ++i) {
+      uint32_t px = np_frames_sweep[f][i];
+      if (NP_COL(i) == sweep_col[f]) {
+        CHECK_EQ(px, NP_ALARM_COLOR);
+        rows |= 1u << NP_ROW(i);
+      } else {
+        CHECK_EQ(px, NP_DIM_COLOR);
+      }
+    }
+    CHECK_EQ(rows, 0x1F);
+  }
+  CHECK_EQ(GRB_R(NP_DIM_COLOR), 8);
+
+  // Apagado
+  CHECK_EQ(lit_count(np_frames_off[0]), 0);
+
+  // Animações de cada nível de alarme e escolha do quadro proporcional
+  CHECK(np_alarm_animations[0] == &np_anim_off);
+  CHECK(np_alarm_animations[1] == &np_anim_level && np_anim_level.proportional);
+  CHECK(np_alarm_animations[2] == &np_anim_pulse && np_anim_pulse.loop);
+  CHECK_EQ(np_animation_frame(&np_anim_level, 0), 0);
+  CHECK_EQ(np_animation_frame(&np_anim_level, 255), NP_MATRIX_LEDS);
+  CHECK_EQ(np_animation_frame(&np_anim_level, 128), 13);
+  CHECK_EQ(np_animation_frame(&np_anim_off, 200), 0);
+  for (int amount = 1; amount < 256; ++amount)
+    CHECK(np_animation_frame(&np_anim_level, (uint8_t)amount) >= np_animation_frame(&np_anim_level, (uint8_t)(amount - 1)));
+
+  return check_result("frames");
+}
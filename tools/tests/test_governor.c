@@ -0,0 +1,115 @@
+// Governador sobre um relógio virtual: sequência de estados com a configuração
+// do firmware, cadência de atualização em cada estado, permanência, despertares
+// e retorno a ACTIVE por botão, por nível acima do limiar e por saturação do ADC.
+
+#include <string.h>
+#include "inc/power/governor.h"
+#include "check.h"
+
+#define STEP_MS 100 // intervalo entre medições simuladas
+
+typedef struct {
+  uint32_t entered_ms[GOVERNOR_STATE_COUNT]; // primeira entrada em cada estado
+  unsigned refreshes[GOVERNOR_STATE_COUNT];  // atualizações da GUI em cada estado
+} trace_t;
+
+// Mede de from_ms até to_ms (inclusive) com o nível oscilando entre db e db + 2
+static void run(governor_t *g, trace_t *t, uint32_t from_ms, uint32_t to_ms, unsigned int db) {
+  for (uint32_t now = from_ms; now <= to_ms; now += STEP_MS) {
+    governor_state_t before = g->state;
+    governor_state_t state = governor_update(g, now, db + (now / STEP_MS) % 2 * 2);
+
+    if (state != before && t->entered_ms[state] == 0)
+      t->entered_ms[state] = now;
+    if (governor_refresh_due(g, now))
+      t->refreshes[state]++;
+  }
+}
+
+int main(void) {
+  governor_t g;
+  trace_t t;
+  const governor_config_t *cfg = &governor_default_config;
+
+  memset(&t, 0, sizeof(t));
+  governor_init(&g, cfg, 0);
+
+  // Primeira medição define a referência; a variação de 2 dB não é atividade
+  run(&g, &t, 0, 130000, 40);
+
+  CHECK_EQ(g.state, GOVERNOR_SLEEP);
+  CHECK_EQ(t.entered_ms[GOVERNOR_STABLE], cfg->stable_after_ms);
+  CHECK_EQ(t.entered_ms[GOVERNOR_DIM], cfg->dim_after_ms);
+  CHECK_EQ(t.entered_ms[GOVERNOR_SLEEP], cfg->sleep_after_ms);
+
+  // ACTIVE atualiza a cada medição; STABLE e DIM no intervalo configurado;
+  // SLEEP apenas na entrada (apaga o display)
+  CHECK_EQ(t.refreshes[GOVERNOR_ACTIVE], cfg->stable_after_ms / STEP_MS);
+  CHECK_EQ(t.refreshes[GOVERNOR_STABLE], (cfg->dim_after_ms - cfg->stable_after_ms) / cfg->refresh_ms[GOVERNOR_STABLE]);
+  CHECK_EQ(t.refreshes[GOVERNOR_DIM], (cfg->sleep_after_ms - cfg->dim_after_ms) / cfg->refresh_ms[GOVERNOR_DIM]);
+  CHECK_EQ(t.refreshes[GOVERNOR_SLEEP], 1);
+
+  CHECK_EQ(g.residency_ms[GOVERNOR_ACTIVE], 5000);
+  CHECK_EQ(g.residency_ms[GOVERNOR_STABLE], 25000);
+  CHECK_EQ(g.residency_ms[GOVERNOR_DIM], 90000);
+  CHECK_EQ(g.residency_ms[GOVERNOR_SLEEP], 10000);
+  CHECK_EQ(g.wakeups, 0);
+  CHECK(governor_sample_window_ms(&g, 50) == cfg->watch_window_ms);
+  CHECK(!governor_display_on(&g));
+  CHECK_EQ(governor_contrast(&g), cfg->contrast[GOVERNOR_SLEEP]);
+
+  // Em vigília, variação abaixo do limiar não acorda
+  CHECK_EQ(governor_update(&g, 130100, 55), GOVERNOR_SLEEP);
+  CHECK(!governor_refresh_due(&g, 130100));
+
+  // Nível acima do limiar acorda e força a atualização da GUI
+  CHECK_EQ(governor_update(&g, 130200, 70), GOVERNOR_ACTIVE);
+  CHECK_EQ(g.wakeups, 1);
+  CHECK(governor_refresh_due(&g, 130200));
+  CHECK(governor_display_on(&g));
+
+  // Volta a dormir e acorda pelo botão, sem mudança no nível
+  memset(&t, 0, sizeof(t));
+  run(&g, &t, 130300, 130300 + cfg->sleep_after_ms, 40);
+  CHECK_EQ(g.state, GOVERNOR_SLEEP);
+  CHECK_EQ(t.entered_ms[GOVERNOR_SLEEP], 130300 + cfg->sleep_after_ms);
+
+  uint32_t now = 130300 + cfg->sleep_after_ms + STEP_MS;
+  CHECK_EQ(governor_update(&g, now, 40), GOVERNOR_SLEEP);
+  governor_notify_input(&g);
+  now += STEP_MS;
+  CHECK_EQ(governor_update(&g, now, 40), GOVERNOR_ACTIVE);
+  CHECK_EQ(g.wakeups, 2);
+  CHECK(governor_refresh_due(&g, now));
+  CHECK(!g.input_pending);
+
+  // Janelas saturadas mantêm o último nível válido (baixo); GOVERNOR_DB_OVERLOAD
+  // acorda da vigília e também sai de DIM
+  memset(&t, 0, sizeof(t));
+  run(&g, &t, now + STEP_MS, now + cfg->sleep_after_ms, 40);
+  now += cfg->sleep_after_ms + STEP_MS;
+  CHECK_EQ(governor_update(&g, now, 40), GOVERNOR_SLEEP);
+  now += STEP_MS;
+  CHECK_EQ(governor_update(&g, now, GOVERNOR_DB_OVERLOAD), GOVERNOR_ACTIVE);
+  CHECK_EQ(g.wakeups, 3);
+  CHECK(governor_refresh_due(&g, now));
+
+  run(&g, &t, now + STEP_MS, now + cfg->dim_after_ms, 40);
+  now += cfg->dim_after_ms + STEP_MS;
+  CHECK_EQ(governor_update(&g, now, 40), GOVERNOR_DIM);
+  now += STEP_MS;
+  CHECK_EQ(governor_update(&g, now, GOVERNOR_DB_OVERLOAD), GOVERNOR_ACTIVE);
+  CHECK_EQ(g.wakeups, 4);
+
+  // Permanência total igual ao tempo simulado
+  uint64_t total = 0;
+  for (int i = 0; i < GOVERNOR_STATE_COUNT; ++i)
+    total += g.residency_ms[i];
+  CHECK_EQ(total, now);
+
+  char buf[128];
+  governor_format_residency(&g, buf, sizeof(buf));
+  CHECK(strstr(buf, "despertares 4") != NULL);
+
+  return check_result("governor");
+}
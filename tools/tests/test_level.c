@@ -0,0 +1,111 @@
+// Diagnóstico da janela de medição (inc/audio/level.h): contagem de amostras
+// saturadas, leitura mantida em janelas saturadas, sinal abaixo da faixa, nível
+// DC, piso de ruído e faixa dinâmica.
+
+#include "inc/audio/level.h"
+#include "check.h"
+
+static void push_repeated(level_window_t *w, uint16_t sample, unsigned n) {
+  for (unsigned i = 0; i < n; ++i)
+    level_window_push(w, sample);
+}
+
+int main(void) {
+  level_window_t w;
+  level_reading_t reading = { 0 };
+  level_noise_t noise;
+  uint8_t amount;
+
+  // Amostras nos trilhos são contadas como saturadas e ficam fora de máximo, mínimo e DC
+  static const uint16_t clipped[] = { 0, LEVEL_ADC_MAX, 2000, 0, LEVEL_ADC_MAX, 2100, LEVEL_ADC_MAX };
+  level_window_reset(&w);
+  level_window_push_block(&w, clipped, sizeof(clipped) / sizeof(clipped[0]));
+  CHECK_EQ(w.clip_low, 2);
+  CHECK_EQ(w.clip_high, 3);
+  CHECK_EQ(w.count, 2);
+  CHECK_EQ(level_window_peak_to_peak(&w), 100);
+  CHECK_EQ(level_window_dc_offset(&w), 2050);
+  CHECK_EQ(level_window_flags(&w), LEVEL_FLAG_OVERLOAD);
+  CHECK(!level_window_valid(&w));
+
+  // A mesma janela combinada a partir de duas metades
+  level_window_t a, b;
+  level_window_reset(&a);
+  level_window_reset(&b);
+  level_window_push_block(&a, clipped, 3);
+  level_window_push_block(&b, clipped + 3, 4);
+  level_window_merge(&a, &b);
+  CHECK_EQ(a.clip_low, w.clip_low);
+  CHECK_EQ(a.clip_high, w.clip_high);
+  CHECK_EQ(a.sum, w.sum);
+  CHECK_EQ(level_window_peak_to_peak(&a), 100);
+
+  // Leitura válida: 1000 de pico a pico = 60 dB
+  level_window_reset(&w);
+  push_repeated(&w, 1500, 10);
+  push_repeated(&w, 2500, 10);
+  level_reading_update(&reading, &w);
+  CHECK(reading.valid);
+  CHECK_EQ(reading.peak_to_peak, 1000);
+  CHECK_EQ(reading.db, 60);
+  CHECK_EQ(reading.flags, 0);
+
+  // Janela saturada: o último nível é mantido, a leitura fica inválida e o alarme é crítico
+  level_window_reset(&w);
+  push_repeated(&w, 2048, 10);
+  level_window_push(&w, LEVEL_ADC_MAX);
+  level_reading_update(&reading, &w);
+  CHECK(!reading.valid);
+  CHECK_EQ(reading.db, 60);
+  CHECK_EQ(reading.peak_to_peak, 1000);
+  CHECK_EQ(reading.flags & LEVEL_FLAG_OVERLOAD, LEVEL_FLAG_OVERLOAD);
+  CHECK_EQ(level_alarm_level(&reading, 90, true, &amount), LEVEL_ALARM_CRITICAL);
+  CHECK_EQ(amount, 255);
+  CHECK_EQ(level_alarm_level(&reading, 90, false, &amount), LEVEL_ALARM_NONE);
+  CHECK_EQ(amount, 0);
+
+  // Apenas amostras saturadas: nenhuma amostra válida
+  level_window_reset(&w);
+  push_repeated(&w, LEVEL_ADC_MIN, 5);
+  CHECK_EQ(w.count, 0);
+  CHECK_EQ(level_window_dc_offset(&w), 0);
+  CHECK(!level_window_valid(&w));
+
+  // Entrada silenciosa (constante): abaixo da faixa, DC igual à constante
+  level_window_reset(&w);
+  push_repeated(&w, 1234, 1000);
+  level_reading_update(&reading, &w);
+  CHECK_EQ(reading.flags, LEVEL_FLAG_UNDERRANGE);
+  CHECK(reading.valid);
+  CHECK_EQ(reading.peak_to_peak, 0);
+  CHECK_EQ(reading.db, 0);
+  CHECK_EQ(level_window_dc_offset(&w), 1234);
+
+  // Piso de ruído zero: a faixa é limitada pela resolução, 20 log10(4093) = 72 dB
+  level_noise_reset(&noise);
+  CHECK_EQ(level_dynamic_range_db(&noise), 0);
+  level_noise_update(&noise, reading.peak_to_peak);
+  CHECK_EQ(level_noise_floor(&noise), 0);
+  CHECK_EQ(level_dynamic_range_db(&noise), 72);
+
+  // Ruído de 2 passos: ainda abaixo da faixa; o piso sobe devagar
+  level_window_reset(&w);
+  push_repeated(&w, 2047, 10);
+  push_repeated(&w, 2049, 10);
+  CHECK_EQ(level_window_flags(&w), LEVEL_FLAG_UNDERRANGE);
+  CHECK_EQ(level_window_dc_offset(&w), 2048);
+  level_noise_reset(&noise);
+  level_noise_update(&noise, level_window_peak_to_peak(&w));
+  CHECK_EQ(level_noise_floor(&noise), 2);
+  CHECK_EQ(level_dynamic_range_db(&noise), 66);
+
+  // Um ruído alto eleva o piso em 1/LEVEL_NOISE_RISE; uma janela silenciosa o derruba na hora
+  level_noise_update(&noise, 1000);
+  CHECK_EQ(noise.floor_q8, (2u << 8) + ((1000u << 8) - (2u << 8)) / LEVEL_NOISE_RISE);
+  CHECK_EQ(level_noise_floor(&noise), 18);
+  level_noise_update(&noise, 3);
+  CHECK_EQ(level_noise_floor(&noise), 3);
+  CHECK_EQ(noise.windows, 3);
+
+  return check_result("level");
+}
@@ -0,0 +1,113 @@
+// Espelhamento do display: as linhas geradas por mirror_encode são aplicadas por
+// um visualizador simulado (como o tools/fbviewer), que deve reproduzir cada
+// quadro enviado. Uma linha que não cabe no buffer não altera o estado do
+// codificador, e mirror_request_keyframe() faz o próximo quadro ser chave.
+
+#include <stdio.h>
+#include <string.h>
+#include "inc/display/mirror.h"
+#include "check.h"
+
+#define W 128
+#define H 64
+#define FRAME_LEN (W * H / 8)
+
+// Estado do visualizador
+typedef struct {
+  uint8_t frame[MIRROR_MAX_FRAME];
+  unsigned seq;
+  char kind;
+} viewer_t;
+
+// Aplica uma linha "@FB ..." ao quadro do visualizador
+static int viewer_apply(viewer_t *v, const char *line) {
+  static uint8_t encoded[MIRROR_MAX_ENCODED];
+  unsigned seq, screen, width, height;
+  char kind;
+  int head = 0;
+
+  if (sscanf(line, "@FB %u %u %c %u %u %n", &seq, &screen, &kind, &width, &height, &head) != 5 || head == 0)
+    return -1;
+
+  size_t b64_len = strcspn(line + head, "\n");
+  long enc_len = mirror_base64_decode(line + head, b64_len, encoded, sizeof(encoded));
+  if (enc_len < 0)
+    return -1;
+
+  if (kind == 'k')
+    memset(v->frame, 0, FRAME_LEN);
+  v->seq = seq;
+  v->kind = kind;
+  return mirror_rle_apply(encoded, (size_t)enc_len, v->frame, FRAME_LEN);
+}
+
+// Quadro de teste: faixa horizontal na página page e alguns pixels soltos
+static void draw(uint8_t *fb, unsigned page, uint8_t pattern) {
+  memset(fb, 0, FRAME_LEN);
+  memset(fb + page * W, pattern, W);
+  fb[FRAME_LEN - 1] = (uint8_t)(pattern ^ 0x81);
+}
+
+int main(void) {
+  static mirror_t m;
+  static char line[MIRROR_MAX_LINE];
+  static uint8_t fb[FRAME_LEN];
+  static viewer_t v;
+  uint32_t now = 0;
+  size_t len;
+
+  mirror_init(&m, W, H, 0, 25);
+
+  // Primeiro quadro: chave
+  draw(fb, 0, 0xFF);
+  CHECK(mirror_capture(&m, fb, 1, now += 10));
+  CHECK((len = mirror_encode(&m, line, sizeof(line))) > 0);
+  CHECK_EQ(viewer_apply(&v, line), 0);
+  CHECK_EQ(v.kind, 'k');
+  CHECK_EQ(v.seq, 0);
+  CHECK(memcmp(v.frame, fb, FRAME_LEN) == 0);
+
+  // Linha maior que o buffer: descartada sem avançar o quadro de referência nem a sequência
+  draw(fb, 3, 0xA5);
+  CHECK(mirror_capture(&m, fb, 1, now += 10));
+  CHECK_EQ(mirror_encode(&m, line, 40), 0);
+  CHECK(!m.pending_ready);
+
+  // O quadro seguinte é relativo ao último que o visualizador recebeu
+  draw(fb, 5, 0x3C);
+  CHECK(mirror_capture(&m, fb, 1, now += 10));
+  CHECK(mirror_encode(&m, line, sizeof(line)) > 0);
+  CHECK_EQ(viewer_apply(&v, line), 0);
+  CHECK_EQ(v.kind, 'd');
+  CHECK_EQ(v.seq, 1);
+  CHECK(memcmp(v.frame, fb, FRAME_LEN) == 0);
+
+  // Linha codificada que não chega ao visualizador (USB desconectada): com o
+  // pedido de quadro chave, o próximo quadro o reconstrói por inteiro
+  draw(fb, 6, 0x0F);
+  CHECK(mirror_capture(&m, fb, 1, now += 10));
+  CHECK(mirror_encode(&m, line, sizeof(line)) > 0);
+  mirror_request_keyframe(&m);
+
+  draw(fb, 7, 0xF0);
+  CHECK(mirror_capture(&m, fb, 2, now += 10));
+  CHECK(mirror_encode(&m, line, sizeof(line)) > 0);
+  CHECK_EQ(viewer_apply(&v, line), 0);
+  CHECK_EQ(v.kind, 'k');
+  CHECK_EQ(v.seq, 3);
+  CHECK(memcmp(v.frame, fb, FRAME_LEN) == 0);
+
+  // Quadro chave pedido mesmo sem mudança no quadro
+  mirror_request_keyframe(&m);
+  CHECK(mirror_capture(&m, fb, 2, now += 10));
+  CHECK(mirror_encode(&m, line, sizeof(line)) > 0);
+  CHECK_EQ(viewer_apply(&v, line), 0);
+  CHECK_EQ(v.kind, 'k');
+  CHECK(memcmp(v.frame, fb, FRAME_LEN) == 0);
+
+  // Sem mudança e sem pedido: nada a enviar
+  CHECK(mirror_capture(&m, fb, 2, now += 10));
+  CHECK_EQ(mirror_encode(&m, line, sizeof(line)), 0);
+
+  return check_result("mirror");
+}
@@ -0,0 +1,139 @@
+// Telemetria por uma conexão UDP local (loopback): registros colocados na fila
+// além da capacidade, datagramas codificados por telemetry_encode e conferidos
+// byte a byte, e a contagem do receptor (telemetry_rx_receive) para registros
+// descartados pela fila e para um datagrama que não chega.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "inc/net/telemetry.h"
+#include "check.h"
+
+static int tx_fd = -1, rx_fd = -1;
+static struct sockaddr_in rx_addr;
+
+static uint32_t get32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void push(telemetry_t *t, uint32_t from, uint32_t count) {
+  for (uint32_t i = from; i < from + count; ++i) {
+    telemetry_record_t r = {
+      .t_ms = i * 50,
+      .peak_to_peak = (uint16_t)(i * 7),
+      .db = (uint8_t)(i % 120),
+      .flags = (uint8_t)(i % 4),
+      .alarm = (uint8_t)(i % 3),
+    };
+    telemetry_push(t, &r);
+  }
+}
+
+// Codifica o próximo datagrama e o envia (ou descarta, simulando a perda na rede)
+static size_t send_next(telemetry_t *t, uint8_t *buf, uint32_t now_ms, bool deliver) {
+  size_t len = telemetry_encode(t, buf, TELEMETRY_MAX_DATAGRAM, now_ms);
+  if (len > 0 && deliver)
+    CHECK_EQ(sendto(tx_fd, buf, len, 0, (struct sockaddr *)&rx_addr, sizeof(rx_addr)), len);
+  return len;
+}
+
+// Recebe um datagrama pelo socket e o entrega ao receptor
+static int receive(telemetry_rx_t *rx, telemetry_header_t *h, telemetry_record_t *records) {
+  static uint8_t buf[2048];
+  ssize_t len = recv(rx_fd, buf, sizeof(buf), 0);
+  if (len < 0)
+    return -2;
+  return telemetry_rx_receive(rx, buf, (size_t)len, h, records, TELEMETRY_MAX_BATCH);
+}
+
+int main(void) {
+  static telemetry_t t;
+  static uint8_t datagram[TELEMETRY_MAX_DATAGRAM];
+  static telemetry_record_t records[TELEMETRY_MAX_BATCH];
+  telemetry_rx_t rx;
+  telemetry_header_t h;
+  socklen_t addr_len = sizeof(rx_addr);
+  struct timeval timeout = { .tv_sec = 2 };
+
+  // Receptor em uma porta livre do loopback
+  rx_fd = socket(AF_INET, SOCK_DGRAM, 0);
+  tx_fd = socket(AF_INET, SOCK_DGRAM, 0);
+  CHECK(rx_fd >= 0 && tx_fd >= 0);
+  rx_addr.sin_family = AF_INET;
+  rx_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  CHECK_EQ(bind(rx_fd, (struct sockaddr *)&rx_addr, sizeof(rx_addr)), 0);
+  CHECK_EQ(getsockname(rx_fd, (struct sockaddr *)&rx_addr, &addr_len), 0);
+  setsockopt(rx_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  if (check_failures)
+    return check_result("telemetry");
+
+  telemetry_init(&t, 1000, 0);
+  telemetry_rx_init(&rx);
+
+  // Fila cheia: os registros mais antigos dão lugar aos novos
+  push(&t, 0, TELEMETRY_QUEUE_LEN + 40);
+  CHECK_EQ(t.count, TELEMETRY_QUEUE_LEN);
+  CHECK_EQ(t.dropped, 40);
+  CHECK(telemetry_due(&t, 0));
+
+  // Cabeçalho de 16 bytes e registros de 9 bytes, little-endian
+  size_t len = send_next(&t, datagram, 10, true);
+  CHECK_EQ(len, TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_BATCH * TELEMETRY_RECORD_SIZE);
+  CHECK(datagram[0] == 'D' && datagram[1] == 'T');
+  CHECK_EQ(datagram[2], TELEMETRY_VERSION);
+  CHECK_EQ(datagram[3], TELEMETRY_MAX_BATCH);
+  CHECK_EQ(get32(datagram + 4), 40); // primeiro registro ainda na fila
+  CHECK_EQ(get32(datagram + 8), 40);
+  CHECK_EQ(get32(datagram + 12), 0);
+  const uint8_t *r = datagram + TELEMETRY_HEADER_SIZE + TELEMETRY_RECORD_SIZE; // registro 41
+  CHECK_EQ(get32(r), 41 * 50);
+  CHECK_EQ(r[4] | (r[5] << 8), 41 * 7);
+  CHECK_EQ(r[6], 41);
+  CHECK_EQ(r[7], 41 % 4);
+  CHECK_EQ(r[8], 41 % 3);
+
+  // Pelo socket, o receptor obtém os mesmos registros
+  CHECK_EQ(receive(&rx, &h, records), TELEMETRY_MAX_BATCH);
+  CHECK_EQ(h.first_seq, 40);
+  CHECK_EQ(h.dropped, 40);
+  CHECK_EQ(records[0].t_ms, 40 * 50);
+  CHECK_EQ(records[TELEMETRY_MAX_BATCH - 1].db, (40 + TELEMETRY_MAX_BATCH - 1) % 120);
+
+  // Um datagrama perdido na rede: a lacuna é contada como perda, não como descarte
+  send_next(&t, datagram, 20, false);
+  send_next(&t, datagram, 30, true);
+  CHECK_EQ(receive(&rx, &h, records), TELEMETRY_MAX_BATCH);
+  CHECK_EQ(h.first_seq, 40 + 2 * TELEMETRY_MAX_BATCH);
+  CHECK_EQ(rx.stats.lost, TELEMETRY_MAX_BATCH);
+  CHECK_EQ(rx.stats.dropped, 0);
+
+  // Rede fora do ar: a fila descarta; a lacuna seguinte é atribuída ao emissor
+  push(&t, TELEMETRY_QUEUE_LEN + 40, TELEMETRY_QUEUE_LEN);
+  CHECK_EQ(t.dropped, 40 + TELEMETRY_MAX_BATCH);
+  send_next(&t, datagram, 40, true);
+  CHECK_EQ(receive(&rx, &h, records), TELEMETRY_MAX_BATCH);
+  CHECK_EQ(rx.stats.dropped, TELEMETRY_MAX_BATCH);
+  CHECK_EQ(rx.stats.lost, TELEMETRY_MAX_BATCH);
+
+  // Datagrama repetido: não conta registros de novo
+  CHECK_EQ(sendto(tx_fd, datagram, TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_BATCH * TELEMETRY_RECORD_SIZE, 0,
+                  (struct sockaddr *)&rx_addr, sizeof(rx_addr)),
+           TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_BATCH * TELEMETRY_RECORD_SIZE);
+  CHECK_EQ(receive(&rx, &h, records), 0);
+  CHECK_EQ(rx.stats.out_of_order, 1);
+
+  // Datagrama truncado: inválido
+  CHECK_EQ(telemetry_rx_receive(&rx, datagram, TELEMETRY_HEADER_SIZE + 5, &h, records, TELEMETRY_MAX_BATCH), -1);
+  CHECK_EQ(rx.stats.invalid, 1);
+
+  // Desde o primeiro datagrama, todo registro gerado foi recebido, descartado ou perdido
+  CHECK_EQ(rx.stats.records, 3 * TELEMETRY_MAX_BATCH);
+  CHECK_EQ(rx.stats.records + rx.stats.dropped + rx.stats.lost, rx.next_seq - 40);
+  CHECK_EQ(rx.stats.datagrams, 4);
+
+  close(rx_fd);
+  close(tx_fd);
+  return check_result("telemetry");
+}